@@ -37,6 +37,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "../../MainRemoteProtocolBridgeComponent.h"
 #include "../../NodeComponent.h"
 #include "../../ProtocolComponent.h"
+#include "../../TrafficLogging/TrafficLoggingConfig.h"
 #include <RemoteProtocolBridgeCommon.h>
 
 //==============================================================================
@@ -65,6 +66,62 @@ GlobalConfigComponent::GlobalConfigComponent()
 	m_EnableEngineOnAppStartLabel->setText("Automatically start engine on app start", dontSendNotification);
 	m_EnableEngineOnAppStartLabel->attachToComponent(m_EnableEngineOnAppStartCheck.get(), true);
 
+	m_TrafficLogMaxRecordsEdit = std::make_unique<TextEditor>();
+	m_TrafficLogMaxRecordsEdit->setInputRestrictions(9, "0123456789");
+	addAndMakeVisible(m_TrafficLogMaxRecordsEdit.get());
+
+	m_TrafficLogMaxRecordsLabel = std::make_unique<Label>();
+	addAndMakeVisible(m_TrafficLogMaxRecordsLabel.get());
+	m_TrafficLogMaxRecordsLabel->setText("Traffic log max. entries", dontSendNotification);
+	m_TrafficLogMaxRecordsLabel->attachToComponent(m_TrafficLogMaxRecordsEdit.get(), true);
+
+	m_TrafficLogMaxMemoryEdit = std::make_unique<TextEditor>();
+	m_TrafficLogMaxMemoryEdit->setInputRestrictions(5, "0123456789");
+	addAndMakeVisible(m_TrafficLogMaxMemoryEdit.get());
+
+	m_TrafficLogMaxMemoryLabel = std::make_unique<Label>();
+	addAndMakeVisible(m_TrafficLogMaxMemoryLabel.get());
+	m_TrafficLogMaxMemoryLabel->setText("Traffic log max. memory (MB)", dontSendNotification);
+	m_TrafficLogMaxMemoryLabel->attachToComponent(m_TrafficLogMaxMemoryEdit.get(), true);
+
+	m_TrafficLogMaxAgeEdit = std::make_unique<TextEditor>();
+	m_TrafficLogMaxAgeEdit->setInputRestrictions(7, "0123456789");
+	addAndMakeVisible(m_TrafficLogMaxAgeEdit.get());
+
+	m_TrafficLogMaxAgeLabel = std::make_unique<Label>();
+	addAndMakeVisible(m_TrafficLogMaxAgeLabel.get());
+	m_TrafficLogMaxAgeLabel->setText("Traffic log max. age (s, 0 = unlimited)", dontSendNotification);
+	m_TrafficLogMaxAgeLabel->attachToComponent(m_TrafficLogMaxAgeEdit.get(), true);
+
+	m_StatsExportFormatDrop = std::make_unique<ComboBox>();
+	m_StatsExportFormatDrop->addItem("Off", TSEF_Off + 1);
+	m_StatsExportFormatDrop->addItem("Prometheus text", TSEF_Prometheus + 1);
+	m_StatsExportFormatDrop->addItem("JSON lines", TSEF_JsonLines + 1);
+	addAndMakeVisible(m_StatsExportFormatDrop.get());
+
+	m_StatsExportFormatLabel = std::make_unique<Label>();
+	addAndMakeVisible(m_StatsExportFormatLabel.get());
+	m_StatsExportFormatLabel->setText("Statistics export format", dontSendNotification);
+	m_StatsExportFormatLabel->attachToComponent(m_StatsExportFormatDrop.get(), true);
+
+	m_StatsExportIntervalEdit = std::make_unique<TextEditor>();
+	m_StatsExportIntervalEdit->setInputRestrictions(5, "0123456789");
+	addAndMakeVisible(m_StatsExportIntervalEdit.get());
+
+	m_StatsExportIntervalLabel = std::make_unique<Label>();
+	addAndMakeVisible(m_StatsExportIntervalLabel.get());
+	m_StatsExportIntervalLabel->setText("Statistics export interval (s)", dontSendNotification);
+	m_StatsExportIntervalLabel->attachToComponent(m_StatsExportIntervalEdit.get(), true);
+
+	m_StatsExportFileEdit = std::make_unique<TextEditor>();
+	m_StatsExportFileEdit->setTextToShowWhenEmpty("Default location", Colours::grey);
+	addAndMakeVisible(m_StatsExportFileEdit.get());
+
+	m_StatsExportFileLabel = std::make_unique<Label>();
+	addAndMakeVisible(m_StatsExportFileLabel.get());
+	m_StatsExportFileLabel->setText("Statistics file", dontSendNotification);
+	m_StatsExportFileLabel->attachToComponent(m_StatsExportFileEdit.get(), true);
+
 	m_applyConfigButton = std::make_unique <TextButton>("Ok");
 	addAndMakeVisible(m_applyConfigButton.get());
 	m_applyConfigButton->addListener(this);
@@ -102,6 +159,22 @@ void GlobalConfigComponent::resized()
 	yOffset += UIS_Margin_s + UIS_ElmSize;
 	m_EnableEngineOnAppStartCheck->setBounds(Rectangle<int>((int)usableWidth - UIS_ElmSize, yOffset, UIS_ElmSize + UIS_Margin_s, UIS_ElmSize));
 
+	// traffic log retention edits
+	yOffset += UIS_Margin_s + UIS_ElmSize;
+	m_TrafficLogMaxRecordsEdit->setBounds(Rectangle<int>((int)usableWidth - UIS_ButtonWidth, yOffset, UIS_ButtonWidth, UIS_ElmSize));
+	yOffset += UIS_Margin_s + UIS_ElmSize;
+	m_TrafficLogMaxMemoryEdit->setBounds(Rectangle<int>((int)usableWidth - UIS_ButtonWidth, yOffset, UIS_ButtonWidth, UIS_ElmSize));
+	yOffset += UIS_Margin_s + UIS_ElmSize;
+	m_TrafficLogMaxAgeEdit->setBounds(Rectangle<int>((int)usableWidth - UIS_ButtonWidth, yOffset, UIS_ButtonWidth, UIS_ElmSize));
+
+	// statistics export controls
+	yOffset += UIS_Margin_s + UIS_ElmSize;
+	m_StatsExportFormatDrop->setBounds(Rectangle<int>((int)usableWidth - 2 * UIS_ButtonWidth, yOffset, 2 * UIS_ButtonWidth, UIS_ElmSize));
+	yOffset += UIS_Margin_s + UIS_ElmSize;
+	m_StatsExportIntervalEdit->setBounds(Rectangle<int>((int)usableWidth - UIS_ButtonWidth, yOffset, UIS_ButtonWidth, UIS_ElmSize));
+	yOffset += UIS_Margin_s + UIS_ElmSize;
+	m_StatsExportFileEdit->setBounds(Rectangle<int>((int)usableWidth - 2 * UIS_ButtonWidth, yOffset, 2 * UIS_ButtonWidth, UIS_ElmSize));
+
 	// ok button
 	yOffset += UIS_Margin_s + UIS_ElmSize;
 	m_applyConfigButton->setBounds(Rectangle<int>((int)usableWidth - UIS_ButtonWidth, yOffset, UIS_ButtonWidth, UIS_ElmSize));
@@ -173,6 +246,24 @@ bool GlobalConfigComponent::DumpTrafficLoggingAllowed()
 		return false;
 }
 
+/**
+ * Method to dump the traffic log retention edit contents as attributes of the given TRAFFICLOGGING element
+ *
+ * @param trafficLoggingXmlElement	The element to set the retention attributes on.
+ */
+void GlobalConfigComponent::DumpTrafficLoggingRetention(XmlElement* trafficLoggingXmlElement)
+{
+	if (!trafficLoggingXmlElement)
+		return;
+
+	if (m_TrafficLogMaxRecordsEdit)
+		trafficLoggingXmlElement->setAttribute(TrafficLoggingAttributes::MaxRecords, m_TrafficLogMaxRecordsEdit->getText().getIntValue());
+	if (m_TrafficLogMaxMemoryEdit)
+		trafficLoggingXmlElement->setAttribute(TrafficLoggingAttributes::MaxMemoryMB, m_TrafficLogMaxMemoryEdit->getText().getIntValue());
+	if (m_TrafficLogMaxAgeEdit)
+		trafficLoggingXmlElement->setAttribute(TrafficLoggingAttributes::MaxAgeSeconds, m_TrafficLogMaxAgeEdit->getText().getIntValue());
+}
+
 /**
  * Setter of state of button for auto-engine-start on app start
  *
@@ -195,6 +286,62 @@ void GlobalConfigComponent::SetTrafficLoggingAllowed(bool allowed)
 		m_AllowTrafficLoggingCheck->setToggleState(allowed, dontSendNotification);
 }
 
+/**
+ * Setter of the traffic log retention edits from the attributes of the given TRAFFICLOGGING element.
+ * Attributes that are not present are shown with their default values.
+ *
+ * @param trafficLoggingXmlElement	The element to read the retention attributes from.
+ */
+void GlobalConfigComponent::SetTrafficLoggingRetention(const XmlElement* trafficLoggingXmlElement)
+{
+	if (!trafficLoggingXmlElement)
+		return;
+
+	if (m_TrafficLogMaxRecordsEdit)
+		m_TrafficLogMaxRecordsEdit->setText(String(trafficLoggingXmlElement->getIntAttribute(TrafficLoggingAttributes::MaxRecords, TLD_MaxRecords)), false);
+	if (m_TrafficLogMaxMemoryEdit)
+		m_TrafficLogMaxMemoryEdit->setText(String(trafficLoggingXmlElement->getIntAttribute(TrafficLoggingAttributes::MaxMemoryMB, TLD_MaxMemoryMB)), false);
+	if (m_TrafficLogMaxAgeEdit)
+		m_TrafficLogMaxAgeEdit->setText(String(trafficLoggingXmlElement->getIntAttribute(TrafficLoggingAttributes::MaxAgeSeconds, TLD_MaxAgeSeconds)), false);
+}
+
+/**
+ * Method to dump the statistics export controls as attributes of the given TRAFFICLOGGING element
+ *
+ * @param trafficLoggingXmlElement	The element to set the statistics export attributes on.
+ */
+void GlobalConfigComponent::DumpTrafficStatisticsExport(XmlElement* trafficLoggingXmlElement)
+{
+	if (!trafficLoggingXmlElement)
+		return;
+
+	if (m_StatsExportFormatDrop)
+		trafficLoggingXmlElement->setAttribute(TrafficLoggingAttributes::StatsExportFormat, jmax(0, m_StatsExportFormatDrop->getSelectedId() - 1));
+	if (m_StatsExportIntervalEdit)
+		trafficLoggingXmlElement->setAttribute(TrafficLoggingAttributes::StatsExportIntervalSeconds, m_StatsExportIntervalEdit->getText().getIntValue());
+	if (m_StatsExportFileEdit)
+		trafficLoggingXmlElement->setAttribute(TrafficLoggingAttributes::StatsExportFile, m_StatsExportFileEdit->getText().trim());
+}
+
+/**
+ * Setter of the statistics export controls from the attributes of the given TRAFFICLOGGING element.
+ * Attributes that are not present are shown with their default values.
+ *
+ * @param trafficLoggingXmlElement	The element to read the statistics export attributes from.
+ */
+void GlobalConfigComponent::SetTrafficStatisticsExport(const XmlElement* trafficLoggingXmlElement)
+{
+	if (!trafficLoggingXmlElement)
+		return;
+
+	if (m_StatsExportFormatDrop)
+		m_StatsExportFormatDrop->setSelectedId(trafficLoggingXmlElement->getIntAttribute(TrafficLoggingAttributes::StatsExportFormat, TLD_StatsExportFormat) + 1, dontSendNotification);
+	if (m_StatsExportIntervalEdit)
+		m_StatsExportIntervalEdit->setText(String(trafficLoggingXmlElement->getIntAttribute(TrafficLoggingAttributes::StatsExportIntervalSeconds, TLD_StatsExportIntervalSeconds)), false);
+	if (m_StatsExportFileEdit)
+		m_StatsExportFileEdit->setText(trafficLoggingXmlElement->getStringAttribute(TrafficLoggingAttributes::StatsExportFile), false);
+}
+
 /**
  * Method to get the components' suggested size. This will be deprecated as soon as
  * the primitive UI is refactored and uses dynamic / proper layouting
@@ -210,6 +357,8 @@ const std::pair<int, int> GlobalConfigComponent::GetSuggestedSize()
 		UIS_ElmSize +
 		UIS_Margin_s + UIS_ElmSize +
 		UIS_ElmSize +
+		3 * (UIS_Margin_s + UIS_ElmSize) +
+		3 * (UIS_Margin_s + UIS_ElmSize) +
 		UIS_Margin_s;
 
 	return std::pair<int, int>(width, height);
@@ -221,7 +370,11 @@ std::unique_ptr<XmlElement> GlobalConfigComponent::createStateXml()
 
 	auto trafficLoggingXmlElement = globalConfigXmlElement->createNewChildElement(ProcessingEngineConfig::getTagName(ProcessingEngineConfig::TagID::TRAFFICLOGGING));
 	if (trafficLoggingXmlElement)
+	{
 		trafficLoggingXmlElement->setAttribute(ProcessingEngineConfig::getAttributeName(ProcessingEngineConfig::AttributeID::ALLOWED), DumpTrafficLoggingAllowed() ? 1 : 0);
+		DumpTrafficLoggingRetention(trafficLoggingXmlElement);
+		DumpTrafficStatisticsExport(trafficLoggingXmlElement);
+	}
 
 	auto engineXmlElement = globalConfigXmlElement->createNewChildElement(ProcessingEngineConfig::getTagName(ProcessingEngineConfig::TagID::ENGINE));
 	if (engineXmlElement)
@@ -237,7 +390,11 @@ bool GlobalConfigComponent::setStateXml(XmlElement* stateXml)
 
 	auto trafficLoggingXmlElement = stateXml->getChildByName(ProcessingEngineConfig::getTagName(ProcessingEngineConfig::TagID::TRAFFICLOGGING));
 	if (trafficLoggingXmlElement)
+	{
 		SetTrafficLoggingAllowed(trafficLoggingXmlElement->getBoolAttribute(ProcessingEngineConfig::getAttributeName(ProcessingEngineConfig::AttributeID::ALLOWED)));
+		SetTrafficLoggingRetention(trafficLoggingXmlElement);
+		SetTrafficStatisticsExport(trafficLoggingXmlElement);
+	}
 	else
 		return false;
 
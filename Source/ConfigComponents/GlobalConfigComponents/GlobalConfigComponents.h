@@ -59,8 +59,12 @@ public:
 	//==============================================================================
 	bool DumpEngineStartOnAppStart();
 	bool DumpTrafficLoggingAllowed();
+	void DumpTrafficLoggingRetention(XmlElement* trafficLoggingXmlElement);
 	void SetEngineStartOnAppStart(bool start);
 	void SetTrafficLoggingAllowed(bool allowed);
+	void SetTrafficLoggingRetention(const XmlElement* trafficLoggingXmlElement);
+	void DumpTrafficStatisticsExport(XmlElement* trafficLoggingXmlElement);
+	void SetTrafficStatisticsExport(const XmlElement* trafficLoggingXmlElement);
 
 	//==============================================================================
 	const std::pair<int, int> GetSuggestedSize();
@@ -89,6 +93,20 @@ private:
 	std::unique_ptr<ToggleButton>	m_AllowTrafficLoggingCheck;		/**< Name label for engine autostart check. */
 	std::unique_ptr<ToggleButton>	m_EnableEngineOnAppStartCheck;	/**< Enable checkbox for engine autostart. */
 
+	std::unique_ptr<Label>			m_TrafficLogMaxRecordsLabel;	/**< Name label for traffic log max. record count edit. */
+	std::unique_ptr<TextEditor>		m_TrafficLogMaxRecordsEdit;		/**< Edit for the max. number of records the traffic log retains. */
+	std::unique_ptr<Label>			m_TrafficLogMaxMemoryLabel;		/**< Name label for traffic log max. memory edit. */
+	std::unique_ptr<TextEditor>		m_TrafficLogMaxMemoryEdit;		/**< Edit for the max. memory in MB the traffic log retains records in. */
+	std::unique_ptr<Label>			m_TrafficLogMaxAgeLabel;		/**< Name label for traffic log max. age edit. */
+	std::unique_ptr<TextEditor>		m_TrafficLogMaxAgeEdit;			/**< Edit for the max. age in seconds of records the traffic log retains. */
+
+	std::unique_ptr<Label>			m_StatsExportFormatLabel;		/**< Name label for statistics export format dropdown. */
+	std::unique_ptr<ComboBox>		m_StatsExportFormatDrop;		/**< Dropdown to select the format of the headless statistics export. */
+	std::unique_ptr<Label>			m_StatsExportIntervalLabel;		/**< Name label for statistics export interval edit. */
+	std::unique_ptr<TextEditor>		m_StatsExportIntervalEdit;		/**< Edit for the interval in seconds statistics snapshots are written with. */
+	std::unique_ptr<Label>			m_StatsExportFileLabel;			/**< Name label for statistics export file edit. */
+	std::unique_ptr<TextEditor>		m_StatsExportFileEdit;			/**< Edit for the full path of the statistics file, empty for the default location. */
+
 	std::unique_ptr<TextButton>		m_applyConfigButton;			/**< Button to apply edited values to configuration. */
 };
 
@@ -0,0 +1,323 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#include "ConfigTree.h"
+
+
+// **************************************************************************************
+//    class ConfigTree
+// **************************************************************************************
+/**
+ * Constructor. Trees are only created through ::FromXml and the editing methods.
+ *
+ * @param tagName	The xml tag, empty for text elements.
+ * @param text		The text of a text element.
+ */
+ConfigTree::ConfigTree(const String& tagName, const String& text)
+	: m_tagName(tagName),
+	m_text(text),
+	m_hash(0)
+{
+}
+
+/**
+ * Destructor
+ */
+ConfigTree::~ConfigTree()
+{
+}
+
+/**
+ * Method to create a tree from xml. If a previous snapshot is given, every subtree that did not change
+ * is taken over from it instead of the newly created one. Children are matched by their position first
+ * and searched among all previous children otherwise, so inserting or removing a node does not unshare
+ * its siblings.
+ *
+ * @param xml		The xml element to create the tree from.
+ * @param previous	The snapshot to share unchanged subtrees with. May be nullptr.
+ * @return	The new tree, or the previous snapshot itself if the contents are equivalent.
+ */
+ConfigTree::Ptr ConfigTree::FromXml(const XmlElement& xml, const Ptr& previous)
+{
+	auto tree = std::shared_ptr<ConfigTree>(new ConfigTree(xml.isTextElement() ? String() : xml.getTagName(), xml.isTextElement() ? xml.getText() : String()));
+
+	tree->m_attributes.reserve(size_t(xml.getNumAttributes()));
+	for (auto i = 0; i < xml.getNumAttributes(); ++i)
+		tree->m_attributes.push_back(std::make_pair(xml.getAttributeName(i), xml.getAttributeValue(i)));
+
+	auto previousChildCount = previous ? previous->GetNumChildren() : 0;
+	tree->m_children.reserve(size_t(xml.getNumChildElements()));
+	for (auto i = 0; i < xml.getNumChildElements(); ++i)
+	{
+		auto child = FromXml(*xml.getChildElement(i), i < previousChildCount ? previous->GetChild(i) : nullptr);
+		if (previous && (i >= previousChildCount || child != previous->GetChild(i)))
+		{
+			for (auto const& previousChild : previous->m_children)
+			{
+				if (child->IsEquivalentTo(previousChild.get()))
+				{
+					child = previousChild;
+					break;
+				}
+			}
+		}
+
+		tree->m_children.push_back(child);
+	}
+
+	tree->UpdateHash();
+
+	if (tree->IsEquivalentTo(previous.get()))
+		return previous;
+
+	return tree;
+}
+
+/**
+ * Method to create a deep xml copy of the tree, e.g. to hand it to interfaces that take ownership.
+ *
+ * @return	The new xml element.
+ */
+std::unique_ptr<XmlElement> ConfigTree::CreateXml() const
+{
+	if (m_tagName.isEmpty())
+		return std::unique_ptr<XmlElement>(XmlElement::createTextElement(m_text));
+
+	auto xml = std::make_unique<XmlElement>(m_tagName);
+	for (auto const& attribute : m_attributes)
+		xml->setAttribute(attribute.first, attribute.second);
+	for (auto const& child : m_children)
+		xml->addChildElement(child->CreateXml().release());
+
+	return xml;
+}
+
+/**
+ * Getter for the xml tag.
+ *
+ * @return	The tag name, empty for text elements.
+ */
+const String& ConfigTree::GetTagName() const
+{
+	return m_tagName;
+}
+
+/**
+ * Getter for the existence of an attribute.
+ *
+ * @param name	The attribute name.
+ * @return	True if the attribute exists.
+ */
+bool ConfigTree::HasAttribute(const String& name) const
+{
+	for (auto const& attribute : m_attributes)
+		if (attribute.first == name)
+			return true;
+
+	return false;
+}
+
+/**
+ * Getter for an attribute value as string.
+ *
+ * @param name			The attribute name.
+ * @param defaultValue	The value to return if the attribute does not exist.
+ * @return	The attribute value.
+ */
+String ConfigTree::GetStringAttribute(const String& name, const String& defaultValue) const
+{
+	for (auto const& attribute : m_attributes)
+		if (attribute.first == name)
+			return attribute.second;
+
+	return defaultValue;
+}
+
+/**
+ * Getter for an attribute value as int.
+ *
+ * @param name			The attribute name.
+ * @param defaultValue	The value to return if the attribute does not exist.
+ * @return	The attribute value.
+ */
+int ConfigTree::GetIntAttribute(const String& name, int defaultValue) const
+{
+	if (!HasAttribute(name))
+		return defaultValue;
+
+	return GetStringAttribute(name).getIntValue();
+}
+
+/**
+ * Getter for an attribute value as bool, with the same interpretation as XmlElement::getBoolAttribute.
+ *
+ * @param name			The attribute name.
+ * @param defaultValue	The value to return if the attribute does not exist.
+ * @return	The attribute value.
+ */
+bool ConfigTree::GetBoolAttribute(const String& name, bool defaultValue) const
+{
+	if (!HasAttribute(name))
+		return defaultValue;
+
+	auto value = GetStringAttribute(name).trimStart();
+	auto firstChar = value[0];
+
+	return firstChar == '1' || firstChar == 't' || firstChar == 'y' || firstChar == 'T' || firstChar == 'Y';
+}
+
+/**
+ * Getter for the number of child trees.
+ *
+ * @return	The number of children.
+ */
+int ConfigTree::GetNumChildren() const
+{
+	return int(m_children.size());
+}
+
+/**
+ * Getter for a child tree.
+ *
+ * @param index	The child index, has to be in range.
+ * @return	The child tree.
+ */
+const ConfigTree::Ptr& ConfigTree::GetChild(int index) const
+{
+	jassert(isPositiveAndBelow(index, GetNumChildren()));
+	return m_children[size_t(index)];
+}
+
+/**
+ * Getter for the first child tree with the given tag.
+ *
+ * @param tagName	The tag to look for.
+ * @return	The child tree, nullptr if there is none.
+ */
+ConfigTree::Ptr ConfigTree::GetChildByName(const String& tagName) const
+{
+	for (auto const& child : m_children)
+		if (child->GetTagName() == tagName)
+			return child;
+
+	return nullptr;
+}
+
+/**
+ * Getter for the content hash. Equivalent trees have equal hashes.
+ *
+ * @return	The hash.
+ */
+uint64 ConfigTree::GetHash() const
+{
+	return m_hash;
+}
+
+/**
+ * Method to compare two trees including all attributes (in order) and children, like XmlElement::isEquivalentTo.
+ * Shared subtrees are equal by identity and trees with different hashes are rejected without walking them.
+ *
+ * @param other	The tree to compare to. May be nullptr.
+ * @return	True if both trees are equivalent.
+ */
+bool ConfigTree::IsEquivalentTo(const ConfigTree* other) const
+{
+	if (other == this)
+		return true;
+	if (!other || other->m_hash != m_hash)
+		return false;
+
+	if (other->m_tagName != m_tagName || other->m_text != m_text || other->m_attributes != m_attributes || other->m_children.size() != m_children.size())
+		return false;
+
+	for (auto i = size_t(0); i < m_children.size(); ++i)
+		if (!m_children[i]->IsEquivalentTo(other->m_children[i].get()))
+			return false;
+
+	return true;
+}
+
+/**
+ * Method to get a tree without the children with the given tag. All other children are shared with this tree.
+ *
+ * @param tagName	The tag of the children to remove.
+ * @return	The edited tree, or this tree if there is no such child.
+ */
+ConfigTree::Ptr ConfigTree::WithoutChildrenNamed(const String& tagName) const
+{
+	if (!GetChildByName(tagName))
+		return shared_from_this();
+
+	auto tree = CreateShallowCopy();
+	tree->m_children.erase(std::remove_if(tree->m_children.begin(), tree->m_children.end(), [&tagName](const Ptr& child) { return child->GetTagName() == tagName; }), tree->m_children.end());
+	tree->UpdateHash();
+
+	return tree;
+}
+
+/**
+ * Helper method to create an editable copy of this tree that shares all children.
+ *
+ * @return	The copy.
+ */
+std::shared_ptr<ConfigTree> ConfigTree::CreateShallowCopy() const
+{
+	auto tree = std::shared_ptr<ConfigTree>(new ConfigTree(m_tagName, m_text));
+	tree->m_attributes = m_attributes;
+	tree->m_children = m_children;
+	tree->m_hash = m_hash;
+
+	return tree;
+}
+
+/**
+ * Helper method to calculate the content hash from tag, text, attributes and the hashes of the children.
+ */
+void ConfigTree::UpdateHash()
+{
+	auto hash = uint64(14695981039346656037ull);
+	auto combine = [&hash](uint64 value) { hash = (hash ^ value) * uint64(1099511628211ull); };
+
+	combine(uint64(m_tagName.hashCode64()));
+	combine(uint64(m_text.hashCode64()));
+	for (auto const& attribute : m_attributes)
+	{
+		combine(uint64(attribute.first.hashCode64()));
+		combine(uint64(attribute.second.hashCode64()));
+	}
+	for (auto const& child : m_children)
+		combine(child->GetHash());
+
+	m_hash = hash;
+}
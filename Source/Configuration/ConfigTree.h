@@ -0,0 +1,93 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+
+/**
+ * Class ConfigTree is an immutable, reference counted representation of a configuration xml tree.
+ * Holding a tree only costs a reference count, so components keep snapshots instead of deep XmlElement copies.
+ * Editing methods return a new tree that shares all unchanged subtrees with the original one.
+ * When a tree is rebuilt from xml against a previous snapshot, unchanged subtrees are taken over from
+ * the snapshot as well, so pointer identity tells whether a subtree changed in between.
+ * Every tree carries a content hash, so trees with different contents are told apart without walking them.
+ */
+class ConfigTree : public std::enable_shared_from_this<ConfigTree>
+{
+public:
+	typedef std::shared_ptr<const ConfigTree> Ptr;
+
+public:
+	~ConfigTree();
+
+	//==============================================================================
+	static Ptr FromXml(const XmlElement& xml, const Ptr& previous = nullptr);
+	std::unique_ptr<XmlElement> CreateXml() const;
+
+	//==============================================================================
+	const String& GetTagName() const;
+	bool HasAttribute(const String& name) const;
+	String GetStringAttribute(const String& name, const String& defaultValue = String()) const;
+	int GetIntAttribute(const String& name, int defaultValue = 0) const;
+	bool GetBoolAttribute(const String& name, bool defaultValue = false) const;
+
+	//==============================================================================
+	int GetNumChildren() const;
+	const Ptr& GetChild(int index) const;
+	Ptr GetChildByName(const String& tagName) const;
+
+	//==============================================================================
+	uint64 GetHash() const;
+	bool IsEquivalentTo(const ConfigTree* other) const;
+
+	//==============================================================================
+	Ptr WithoutChildrenNamed(const String& tagName) const;
+
+private:
+	ConfigTree(const String& tagName, const String& text);
+
+	std::shared_ptr<ConfigTree> CreateShallowCopy() const;
+	void UpdateHash();
+
+private:
+	String									m_tagName;		/**< The xml tag, empty for text elements. */
+	String									m_text;			/**< The text of a text element. */
+	std::vector<std::pair<String, String>>	m_attributes;	/**< The attribute names and values in xml order. */
+	std::vector<Ptr>						m_children;		/**< The shared child trees in xml order. */
+	uint64									m_hash;			/**< Hash over tag, text, attributes and the hashes of all children. */
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ConfigTree)
+};
@@ -0,0 +1,215 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#include "ConfigUpdateCoalescer.h"
+
+
+ConfigUpdateCoalescer* ConfigUpdateCoalescer::s_instance = nullptr;
+
+
+// **************************************************************************************
+//    class ConfigUpdateCoalescer::ScopedTransaction
+// **************************************************************************************
+/**
+ * Constructor. Opens a transaction on the coalescer instance, if there is one.
+ */
+ConfigUpdateCoalescer::ScopedTransaction::ScopedTransaction()
+{
+	if (auto coalescer = ConfigUpdateCoalescer::getInstance())
+		coalescer->BeginTransaction();
+}
+
+/**
+ * Destructor. Ends the transaction and does the dump if this was the outermost one.
+ */
+ConfigUpdateCoalescer::ScopedTransaction::~ScopedTransaction()
+{
+	if (auto coalescer = ConfigUpdateCoalescer::getInstance())
+		coalescer->EndTransaction();
+}
+
+
+// **************************************************************************************
+//    class ConfigUpdateCoalescer
+// **************************************************************************************
+/**
+ * Constructor. The coalescer registers itself as the instance ui components route their requests to.
+ *
+ * @param config	The configuration to dump.
+ */
+ConfigUpdateCoalescer::ConfigUpdateCoalescer(ProcessingEngineConfig& config)
+	: m_config(config),
+	m_dumpPending(false),
+	m_watcherUpdatePending(false),
+	m_transactionDepth(0)
+{
+	jassert(s_instance == nullptr);
+	s_instance = this;
+}
+
+/**
+ * Destructor. Pending edits are not dumped, call ::Flush before if they are to be kept.
+ */
+ConfigUpdateCoalescer::~ConfigUpdateCoalescer()
+{
+	stopTimer();
+
+	if (s_instance == this)
+		s_instance = nullptr;
+}
+
+/**
+ * Getter for the coalescer instance.
+ *
+ * @return	The coalescer, nullptr if none exists.
+ */
+ConfigUpdateCoalescer* ConfigUpdateCoalescer::getInstance()
+{
+	return s_instance;
+}
+
+/**
+ * Static helper for ui components to schedule a dump for a continuous edit.
+ * Without a coalescer instance, the configuration is dumped right away.
+ *
+ * @param includeWatcherUpdate	True if the configuration watchers are to be updated after the dump.
+ */
+void ConfigUpdateCoalescer::ScheduleUpdate(bool includeWatcherUpdate)
+{
+	if (auto coalescer = getInstance())
+		coalescer->ScheduleDump(includeWatcherUpdate);
+	else if (auto config = ProcessingEngineConfig::getInstance())
+		config->triggerConfigurationDump(includeWatcherUpdate);
+}
+
+/**
+ * Static helper for ui components to commit a discrete edit.
+ * Without a coalescer instance, the configuration is dumped right away.
+ *
+ * @param includeWatcherUpdate	True if the configuration watchers are to be updated after the dump.
+ */
+void ConfigUpdateCoalescer::CommitUpdate(bool includeWatcherUpdate)
+{
+	if (auto coalescer = getInstance())
+		coalescer->CommitDump(includeWatcherUpdate);
+	else if (auto config = ProcessingEngineConfig::getInstance())
+		config->triggerConfigurationDump(includeWatcherUpdate);
+}
+
+/**
+ * Method to request a dump that is done once no further request arrived within the coalesce window.
+ * Every request restarts the window, so continuous typing results in a single dump after the last keystroke.
+ *
+ * @param includeWatcherUpdate	True if the configuration watchers are to be updated after the dump.
+ */
+void ConfigUpdateCoalescer::ScheduleDump(bool includeWatcherUpdate)
+{
+	m_dumpPending = true;
+	m_watcherUpdatePending = m_watcherUpdatePending || includeWatcherUpdate;
+
+	if (m_transactionDepth == 0)
+		startTimer(CUC_CoalesceWindowMs);
+}
+
+/**
+ * Method to request a dump that is done right away, together with all edits that are still pending.
+ * Inside a transaction the dump is deferred to the end of the outermost transaction.
+ *
+ * @param includeWatcherUpdate	True if the configuration watchers are to be updated after the dump.
+ */
+void ConfigUpdateCoalescer::CommitDump(bool includeWatcherUpdate)
+{
+	m_dumpPending = true;
+	m_watcherUpdatePending = m_watcherUpdatePending || includeWatcherUpdate;
+
+	if (m_transactionDepth == 0)
+		Flush();
+}
+
+/**
+ * Method to do a pending dump right away.
+ */
+void ConfigUpdateCoalescer::Flush()
+{
+	stopTimer();
+
+	if (!m_dumpPending)
+		return;
+
+	// reset before dumping, dumping may cause watcher callbacks that request again
+	auto includeWatcherUpdate = m_watcherUpdatePending;
+	m_dumpPending = false;
+	m_watcherUpdatePending = false;
+
+	m_config.triggerConfigurationDump(includeWatcherUpdate);
+}
+
+/**
+ * Getter for a requested dump that was not done yet.
+ *
+ * @return	True if edits are waiting for the coalesce window or the end of a transaction.
+ */
+bool ConfigUpdateCoalescer::IsDumpPending() const
+{
+	return m_dumpPending;
+}
+
+/**
+ * Method to open a transaction. Requests are collected until the outermost transaction ends.
+ */
+void ConfigUpdateCoalescer::BeginTransaction()
+{
+	m_transactionDepth++;
+	stopTimer();
+}
+
+/**
+ * Method to end a transaction. When the outermost transaction ends, the collected requests are dumped at once.
+ */
+void ConfigUpdateCoalescer::EndTransaction()
+{
+	jassert(m_transactionDepth > 0);
+	m_transactionDepth = jmax(0, m_transactionDepth - 1);
+
+	if (m_transactionDepth == 0)
+		Flush();
+}
+
+/**
+ * Reimplemented from Timer - the coalesce window passed without further requests.
+ */
+void ConfigUpdateCoalescer::timerCallback()
+{
+	Flush();
+}
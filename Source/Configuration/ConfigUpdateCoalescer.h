@@ -0,0 +1,103 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "ProcessingEngine/ProcessingEngineConfig.h"
+
+
+/**
+ * Class ConfigUpdateCoalescer batches configuration dumps requested by ui edits, so one logical change
+ * causes exactly one dump of the configuration tree and at most one reconfiguration of the engine.
+ * Continuous edits like typing are scheduled and dumped once no further edit arrived within the coalesce window.
+ * Discrete edits are committed right away, together with any edit still pending. Edits that consist of several
+ * steps are wrapped in a ScopedTransaction, that defers all dumps to its end.
+ * The coalescer is owned by the main component and only used on the message thread.
+ */
+class ConfigUpdateCoalescer : private Timer
+{
+public:
+	enum CoalescerConstants
+	{
+		CUC_CoalesceWindowMs = 300,	/**< Time without further edits after which a scheduled dump is done. */
+	};
+
+	/**
+	 * Helper to defer all dumps requested during its lifetime to a single dump when it is destroyed.
+	 * Transactions may be nested, the dump is done when the outermost one ends.
+	 */
+	class ScopedTransaction
+	{
+	public:
+		ScopedTransaction();
+		~ScopedTransaction();
+
+	private:
+		JUCE_DECLARE_NON_COPYABLE(ScopedTransaction)
+	};
+
+public:
+	ConfigUpdateCoalescer(ProcessingEngineConfig& config);
+	~ConfigUpdateCoalescer();
+
+	//==============================================================================
+	static ConfigUpdateCoalescer* getInstance();
+	static void ScheduleUpdate(bool includeWatcherUpdate = true);
+	static void CommitUpdate(bool includeWatcherUpdate = true);
+
+	//==============================================================================
+	void ScheduleDump(bool includeWatcherUpdate);
+	void CommitDump(bool includeWatcherUpdate);
+	void Flush();
+	bool IsDumpPending() const;
+
+	//==============================================================================
+	void BeginTransaction();
+	void EndTransaction();
+
+private:
+	void timerCallback() override;
+
+private:
+	static ConfigUpdateCoalescer*	s_instance;				/**< The coalescer the ui components route their requests to. */
+
+	ProcessingEngineConfig&			m_config;				/**< The configuration that is dumped. */
+	bool							m_dumpPending;			/**< Flag to indicate that a dump was requested but not done yet. */
+	bool							m_watcherUpdatePending;	/**< Flag to indicate that at least one pending request asked for a watcher update. */
+	int								m_transactionDepth;		/**< Count of open transactions. */
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ConfigUpdateCoalescer)
+};
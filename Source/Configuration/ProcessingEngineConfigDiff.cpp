@@ -0,0 +1,328 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#include "ProcessingEngineConfigDiff.h"
+
+#include "ProcessingEngine/ProcessingEngineConfig.h"
+
+
+// **************************************************************************************
+//    class ProcessingEngineConfigDiff
+// **************************************************************************************
+/**
+ * Constructor. The diff is calculated right away, the states are not referenced afterwards.
+ *
+ * @param previousState	The configuration state to compare against, e.g. the one the engine was started with. May be nullptr.
+ * @param currentState	The new configuration state. May be nullptr.
+ */
+ProcessingEngineConfigDiff::ProcessingEngineConfigDiff(const ConfigTree* previousState, const ConfigTree* currentState)
+	: m_engineGlobalChanged(false),
+	m_uiGlobalChanged(false)
+{
+	DiffNodes(previousState, currentState);
+	DiffGlobalConfig(previousState, currentState);
+}
+
+/**
+ * Destructor
+ */
+ProcessingEngineConfigDiff::~ProcessingEngineConfigDiff()
+{
+}
+
+/**
+ * Getter for the overall diff state.
+ *
+ * @return	True if both states are equivalent.
+ */
+bool ProcessingEngineConfigDiff::IsEmpty() const
+{
+	return !AffectsEngine() && !m_uiGlobalChanged;
+}
+
+/**
+ * Getter for the engine relevance of the diff.
+ *
+ * @return	True if a running engine has to pick up the change, false if it can keep bridging untouched.
+ */
+bool ProcessingEngineConfigDiff::AffectsEngine() const
+{
+	return !m_addedNodes.isEmpty() || !m_removedNodes.isEmpty() || !m_changedNodes.isEmpty() || m_engineGlobalChanged;
+}
+
+/**
+ * Getter for the nodes that were added.
+ *
+ * @return	The ids of the added nodes.
+ */
+const Array<NodeId>& ProcessingEngineConfigDiff::GetAddedNodes() const
+{
+	return m_addedNodes;
+}
+
+/**
+ * Getter for the nodes that were removed.
+ *
+ * @return	The ids of the removed nodes.
+ */
+const Array<NodeId>& ProcessingEngineConfigDiff::GetRemovedNodes() const
+{
+	return m_removedNodes;
+}
+
+/**
+ * Getter for the nodes whose configuration changed.
+ *
+ * @return	The ids of the changed nodes.
+ */
+const Array<NodeId>& ProcessingEngineConfigDiff::GetChangedNodes() const
+{
+	return m_changedNodes;
+}
+
+/**
+ * Getter for all nodes that have to be (re-)started or stopped to apply the change.
+ *
+ * @return	The ids of added, removed and changed nodes.
+ */
+Array<NodeId> ProcessingEngineConfigDiff::GetAffectedNodes() const
+{
+	Array<NodeId> affectedNodes;
+	affectedNodes.addArray(m_addedNodes);
+	affectedNodes.addArray(m_removedNodes);
+	affectedNodes.addArray(m_changedNodes);
+
+	return affectedNodes;
+}
+
+/**
+ * Getter for the protocols of a changed node that were added, removed or changed.
+ *
+ * @param nodeId	The id of the changed node.
+ * @return	The protocol ids, empty if the node did not change or only its object handling changed.
+ */
+Array<ProtocolId> ProcessingEngineConfigDiff::GetChangedProtocols(NodeId nodeId) const
+{
+	auto changedProtocols = m_changedProtocols.find(nodeId);
+	if (changedProtocols == m_changedProtocols.end())
+		return {};
+
+	return changedProtocols->second;
+}
+
+/**
+ * Getter for changes of global configuration that is evaluated by the engine.
+ *
+ * @return	True if such global configuration changed.
+ */
+bool ProcessingEngineConfigDiff::HasEngineGlobalChanges() const
+{
+	return m_engineGlobalChanged;
+}
+
+/**
+ * Getter for changes of global configuration that is only evaluated by the ui.
+ *
+ * @return	True if such global configuration changed.
+ */
+bool ProcessingEngineConfigDiff::HasUiGlobalChanges() const
+{
+	return m_uiGlobalChanged;
+}
+
+/**
+ * Method to get a short human readable summary of the diff, e.g. "node 2 (protocols 3), global".
+ *
+ * @return	The summary, "no changes" for an empty diff.
+ */
+String ProcessingEngineConfigDiff::GetDescription() const
+{
+	StringArray parts;
+	for (auto nodeId : m_addedNodes)
+		parts.add("node " + String(nodeId) + " added");
+	for (auto nodeId : m_removedNodes)
+		parts.add("node " + String(nodeId) + " removed");
+	for (auto nodeId : m_changedNodes)
+	{
+		StringArray protocolIds;
+		for (auto protocolId : GetChangedProtocols(nodeId))
+			protocolIds.add(String(protocolId));
+
+		if (protocolIds.isEmpty())
+			parts.add("node " + String(nodeId));
+		else
+			parts.add("node " + String(nodeId) + " (protocols " + protocolIds.joinIntoString(",") + ")");
+	}
+	if (m_engineGlobalChanged)
+		parts.add("global");
+	if (m_uiGlobalChanged)
+		parts.add("ui settings");
+
+	return parts.isEmpty() ? String("no changes") : parts.joinIntoString(", ");
+}
+
+/**
+ * Helper method to collect the direct children of an element with the given tag, keyed by their id attribute.
+ *
+ * @param parent	The element to collect the children of. May be nullptr.
+ * @param tagName	The tag of the children to collect.
+ * @return	The children by id.
+ */
+std::map<int, const ConfigTree*> ProcessingEngineConfigDiff::GetChildrenById(const ConfigTree* parent, const String& tagName)
+{
+	std::map<int, const ConfigTree*> childrenById;
+	if (!parent)
+		return childrenById;
+
+	auto idAttributeName = ProcessingEngineConfig::getAttributeName(ProcessingEngineConfig::AttributeID::ID);
+	for (auto i = 0; i < parent->GetNumChildren(); ++i)
+	{
+		auto child = parent->GetChild(i).get();
+		if (child->GetTagName() == tagName)
+			childrenById[child->GetIntAttribute(idAttributeName)] = child;
+	}
+
+	return childrenById;
+}
+
+/**
+ * Helper method to compare two elements including all attributes and children.
+ * Shared elements are equivalent by identity, elements with different content hashes are not walked.
+ *
+ * @param previous	The previous element. May be nullptr.
+ * @param current	The current element. May be nullptr.
+ * @return	True if both are missing or both are equivalent.
+ */
+bool ProcessingEngineConfigDiff::AreEquivalent(const ConfigTree* previous, const ConfigTree* current)
+{
+	if (!previous || !current)
+		return previous == current;
+
+	return previous->IsEquivalentTo(current);
+}
+
+/**
+ * Helper method to sort the nodes of both states into added, removed and changed ones.
+ *
+ * @param previousState	The previous configuration state.
+ * @param currentState	The current configuration state.
+ */
+void ProcessingEngineConfigDiff::DiffNodes(const ConfigTree* previousState, const ConfigTree* currentState)
+{
+	auto nodeTagName = ProcessingEngineConfig::getTagName(ProcessingEngineConfig::TagID::NODE);
+	auto previousNodes = GetChildrenById(previousState, nodeTagName);
+	auto currentNodes = GetChildrenById(currentState, nodeTagName);
+
+	for (auto const& previousNode : previousNodes)
+		if (currentNodes.count(previousNode.first) == 0)
+			m_removedNodes.add(static_cast<NodeId>(previousNode.first));
+
+	for (auto const& currentNode : currentNodes)
+	{
+		auto nodeId = static_cast<NodeId>(currentNode.first);
+		auto previousNode = previousNodes.find(currentNode.first);
+		if (previousNode == previousNodes.end())
+		{
+			m_addedNodes.add(nodeId);
+		}
+		else if (!AreEquivalent(previousNode->second, currentNode.second))
+		{
+			m_changedNodes.add(nodeId);
+			DiffProtocols(nodeId, previousNode->second, currentNode.second);
+		}
+	}
+}
+
+/**
+ * Helper method to find the protocols of a changed node that differ.
+ * Protocols are matched by role and id, so moving a protocol id from role A to B counts as a change.
+ * A changed node without changed protocols differs in its object handling.
+ *
+ * @param nodeId		The id of the changed node.
+ * @param previousNode	The previous node element.
+ * @param currentNode	The current node element.
+ */
+void ProcessingEngineConfigDiff::DiffProtocols(NodeId nodeId, const ConfigTree* previousNode, const ConfigTree* currentNode)
+{
+	Array<ProtocolId> changedProtocols;
+	for (auto tagId : { ProcessingEngineConfig::TagID::PROTOCOLA, ProcessingEngineConfig::TagID::PROTOCOLB })
+	{
+		auto protocolTagName = ProcessingEngineConfig::getTagName(tagId);
+		auto previousProtocols = GetChildrenById(previousNode, protocolTagName);
+		auto currentProtocols = GetChildrenById(currentNode, protocolTagName);
+
+		for (auto const& previousProtocol : previousProtocols)
+		{
+			auto currentProtocol = currentProtocols.find(previousProtocol.first);
+			if (currentProtocol == currentProtocols.end() || !AreEquivalent(previousProtocol.second, currentProtocol->second))
+				changedProtocols.addIfNotAlreadyThere(static_cast<ProtocolId>(previousProtocol.first));
+		}
+		for (auto const& currentProtocol : currentProtocols)
+			if (previousProtocols.count(currentProtocol.first) == 0)
+				changedProtocols.addIfNotAlreadyThere(static_cast<ProtocolId>(currentProtocol.first));
+	}
+
+	m_changedProtocols[nodeId] = changedProtocols;
+}
+
+/**
+ * Helper method to compare the global configuration. Traffic logging is only evaluated by the ui,
+ * every other difference in the global configuration is considered to affect the engine.
+ *
+ * @param previousState	The previous configuration state.
+ * @param currentState	The current configuration state.
+ */
+void ProcessingEngineConfigDiff::DiffGlobalConfig(const ConfigTree* previousState, const ConfigTree* currentState)
+{
+	auto globalTagName = ProcessingEngineConfig::getTagName(ProcessingEngineConfig::TagID::GLOBALCONFIG);
+	auto trafficLoggingTagName = ProcessingEngineConfig::getTagName(ProcessingEngineConfig::TagID::TRAFFICLOGGING);
+
+	auto previousGlobal = previousState ? previousState->GetChildByName(globalTagName) : nullptr;
+	auto currentGlobal = currentState ? currentState->GetChildByName(globalTagName) : nullptr;
+	if (AreEquivalent(previousGlobal.get(), currentGlobal.get()))
+		return;
+
+	if (!previousGlobal || !currentGlobal)
+	{
+		m_engineGlobalChanged = true;
+		return;
+	}
+
+	m_uiGlobalChanged = !AreEquivalent(previousGlobal->GetChildByName(trafficLoggingTagName).get(), currentGlobal->GetChildByName(trafficLoggingTagName).get());
+
+	// compare the remaining global configuration without the ui-only parts, the stripped trees share all other children
+	auto previousEngineGlobal = previousGlobal->WithoutChildrenNamed(trafficLoggingTagName);
+	auto currentEngineGlobal = currentGlobal->WithoutChildrenNamed(trafficLoggingTagName);
+	m_engineGlobalChanged = !AreEquivalent(previousEngineGlobal.get(), currentEngineGlobal.get());
+}
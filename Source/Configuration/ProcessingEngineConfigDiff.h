@@ -0,0 +1,89 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "RemoteProtocolBridgeCommon.h"
+#include "ConfigTree.h"
+
+
+/**
+ * Class ProcessingEngineConfigDiff compares two configuration states and tells which parts of a
+ * running bridge are affected by the change. Nodes are matched by their id and compared as a whole,
+ * the protocols of changed nodes are additionally matched by role and id to name what changed.
+ * Global configuration that is only evaluated by the ui, like traffic logging, does not affect the engine.
+ * Subtrees shared by both states are recognized as unchanged by identity, without comparing their contents.
+ */
+class ProcessingEngineConfigDiff
+{
+public:
+	ProcessingEngineConfigDiff(const ConfigTree* previousState, const ConfigTree* currentState);
+	~ProcessingEngineConfigDiff();
+
+	//==============================================================================
+	bool IsEmpty() const;
+	bool AffectsEngine() const;
+
+	//==============================================================================
+	const Array<NodeId>& GetAddedNodes() const;
+	const Array<NodeId>& GetRemovedNodes() const;
+	const Array<NodeId>& GetChangedNodes() const;
+	Array<NodeId> GetAffectedNodes() const;
+	Array<ProtocolId> GetChangedProtocols(NodeId nodeId) const;
+	bool HasEngineGlobalChanges() const;
+	bool HasUiGlobalChanges() const;
+
+	//==============================================================================
+	String GetDescription() const;
+
+private:
+	static std::map<int, const ConfigTree*> GetChildrenById(const ConfigTree* parent, const String& tagName);
+	static bool AreEquivalent(const ConfigTree* previous, const ConfigTree* current);
+
+	void DiffNodes(const ConfigTree* previousState, const ConfigTree* currentState);
+	void DiffProtocols(NodeId nodeId, const ConfigTree* previousNode, const ConfigTree* currentNode);
+	void DiffGlobalConfig(const ConfigTree* previousState, const ConfigTree* currentState);
+
+private:
+	Array<NodeId>							m_addedNodes;			/**< Nodes only contained in the current state. */
+	Array<NodeId>							m_removedNodes;			/**< Nodes only contained in the previous state. */
+	Array<NodeId>							m_changedNodes;			/**< Nodes contained in both states with different contents. */
+	std::map<NodeId, Array<ProtocolId>>		m_changedProtocols;		/**< Per changed node the protocols that were added, removed or changed. */
+	bool									m_engineGlobalChanged;	/**< Flag to indicate that global configuration evaluated by the engine differs. */
+	bool									m_uiGlobalChanged;		/**< Flag to indicate that global configuration only evaluated by the ui differs. */
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ProcessingEngineConfigDiff)
+};
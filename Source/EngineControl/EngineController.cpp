@@ -0,0 +1,379 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#include "EngineController.h"
+
+#include "ProcessingEngine/ProcessingEngine.h"
+
+
+// **************************************************************************************
+//    class EngineController
+// **************************************************************************************
+/**
+ * Constructor
+ *
+ * @param engine	The engine to control. It must not be started or stopped other than through this controller.
+ */
+EngineController::EngineController(ProcessingEngine& engine)
+	: Thread("EngineController"),
+	m_engine(engine),
+	m_engineWatcher(engine)
+{
+	m_pendingRequest = ER_None;
+	m_releasedRequest = ER_None;
+	m_executing = false;
+	m_configUpdatePending = false;
+
+	startThread();
+}
+
+/**
+ * Destructor
+ */
+EngineController::~EngineController()
+{
+	Shutdown();
+}
+
+/**
+ * Method to request starting the engine. Returns immediately, the result is reported to the listeners.
+ */
+void EngineController::RequestStart()
+{
+	Request(ER_Start);
+}
+
+/**
+ * Method to request stopping the engine. Returns immediately, the result is reported to the listeners.
+ */
+void EngineController::RequestStop()
+{
+	Request(ER_Stop);
+}
+
+/**
+ * Method to request restarting the engine, if it is running. Returns immediately, the result is reported to the listeners.
+ */
+void EngineController::RequestRestart()
+{
+	Request(ER_Restart);
+}
+
+/**
+ * Method to finish the background thread and stop the engine, for application shutdown.
+ * Unlike the requests, this waits for a request in execution to finish and stops the engine on the calling thread.
+ * No more events are reported afterwards.
+ */
+void EngineController::Shutdown()
+{
+	if (isThreadRunning())
+	{
+		signalThreadShouldExit();
+		notify();
+		stopThread(-1);
+	}
+
+	cancelPendingUpdate();
+
+	if (m_engine.IsRunning())
+		m_engine.Stop();
+	m_state.store(ES_Stopped);
+}
+
+/**
+ * Getter for the engine state.
+ *
+ * @return	The current engine state.
+ */
+EngineController::EngineState EngineController::GetState() const
+{
+	return static_cast<EngineState>(m_state.load());
+}
+
+/**
+ * Getter for the busy state.
+ *
+ * @return	True if a request is waiting or being executed.
+ */
+bool EngineController::IsBusy() const
+{
+	const ScopedLock sl(m_requestLock);
+	return IsBusyLocked();
+}
+
+/**
+ * Method to add a listener to report engine state changes to.
+ *
+ * @param listener	The listener to add.
+ */
+void EngineController::AddListener(Listener* listener)
+{
+	m_listeners.addIfNotAlreadyThere(listener);
+}
+
+/**
+ * Method to remove a listener.
+ *
+ * @param listener	The listener to remove.
+ */
+void EngineController::RemoveListener(Listener* listener)
+{
+	m_listeners.removeFirstMatchingValue(listener);
+}
+
+/**
+ * Reimplemented from ProcessingEngineConfig::Watcher to forward configuration updates to the engine.
+ * While a request is waiting or executed, the update is held back. It is forwarded on the message thread
+ * before the next request is handed to the background thread, or once the engine is idle again.
+ */
+void EngineController::onConfigUpdated()
+{
+	{
+		const ScopedLock sl(m_requestLock);
+		if (IsBusyLocked())
+		{
+			m_configUpdatePending = true;
+			return;
+		}
+
+		m_configUpdatePending = false;
+	}
+
+	m_engineWatcher.onConfigUpdated();
+}
+
+/**
+ * Helper method to queue a request for the background thread. A request still waiting is replaced,
+ * except that a waiting restart is not weakened to a start and a waiting stop is not overridden by a restart,
+ * so the engine never ends up running after the last explicit request was a stop.
+ * The request is handed to the background thread from the message loop, so a configuration update that is
+ * delivered in the same call as the request, like the watcher call following a configuration dump, is held back
+ * and forwarded before the request is executed.
+ *
+ * @param request	The request to queue.
+ */
+void EngineController::Request(EngineRequest request)
+{
+	{
+		const ScopedLock sl(m_requestLock);
+		auto weakensRestart = (request == ER_Start && m_pendingRequest == ER_Restart);
+		auto overridesStop = (request == ER_Restart && m_pendingRequest == ER_Stop);
+		if (!weakensRestart && !overridesStop)
+			m_pendingRequest = request;
+	}
+
+	triggerAsyncUpdate();
+}
+
+/**
+ * Helper method to execute a request on the background thread and report the result.
+ *
+ * @param request	The request to execute.
+ */
+void EngineController::ExecuteRequest(EngineRequest request)
+{
+	auto running = (GetState() == ES_Running);
+	auto startTime = Time::getMillisecondCounterHiRes();
+	auto succeeded = true;
+
+	switch (request)
+	{
+	case ER_Start:
+		if (!running)
+			succeeded = StartEngine();
+		break;
+	case ER_Stop:
+		if (running)
+			StopEngine();
+		break;
+	case ER_Restart:
+		// a stopped engine picks up the configuration when it is started
+		if (!running)
+			return;
+		// the downtime runs from stopping until the engine runs with the new configuration
+		startTime = Time::getMillisecondCounterHiRes();
+		StopEngine();
+		succeeded = StartEngine();
+		break;
+	case ER_None:
+	default:
+		return;
+	}
+
+	PostEvent({ GetState(), request, succeeded, Time::getMillisecondCounterHiRes() - startTime });
+}
+
+/**
+ * Helper method to check if a request is waiting, handed to the background thread or executed.
+ * The request lock must be held by the caller.
+ *
+ * @return	True if a request is waiting or being executed.
+ */
+bool EngineController::IsBusyLocked() const
+{
+	return m_pendingRequest != ER_None || m_releasedRequest != ER_None || m_executing;
+}
+
+/**
+ * Helper method to start the engine on the background thread.
+ *
+ * @return	True if the engine was started.
+ */
+bool EngineController::StartEngine()
+{
+	SetState(ES_Starting);
+	auto started = m_engine.Start();
+	SetState(started ? ES_Running : ES_Stopped);
+
+	return started;
+}
+
+/**
+ * Helper method to stop the engine on the background thread.
+ */
+void EngineController::StopEngine()
+{
+	SetState(ES_Stopping);
+	m_engine.Stop();
+	SetState(ES_Stopped);
+}
+
+/**
+ * Helper method to set a new engine state and report it.
+ *
+ * @param state	The new engine state.
+ */
+void EngineController::SetState(EngineState state)
+{
+	m_state.store(state);
+	PostEvent({ state, ER_None, false, 0.0 });
+}
+
+/**
+ * Helper method to queue an event for delivery on the message thread.
+ *
+ * @param engineEvent	The event to deliver.
+ */
+void EngineController::PostEvent(const EngineEvent& engineEvent)
+{
+	{
+		const ScopedLock sl(m_eventLock);
+		m_events.push_back(engineEvent);
+	}
+
+	triggerAsyncUpdate();
+}
+
+/**
+ * Reimplemented from Thread. Executes the requests handed over by the message thread until the thread is signaled to exit.
+ */
+void EngineController::run()
+{
+	while (!threadShouldExit())
+	{
+		auto request = ER_None;
+		{
+			const ScopedLock sl(m_requestLock);
+			request = m_releasedRequest;
+			m_releasedRequest = ER_None;
+			m_executing = (request != ER_None);
+		}
+
+		if (request == ER_None)
+		{
+			wait(-1);
+			continue;
+		}
+
+		ExecuteRequest(request);
+
+		{
+			const ScopedLock sl(m_requestLock);
+			m_executing = false;
+		}
+
+		// wake the message thread to forward configuration updates that were held back and hand over the next request
+		triggerAsyncUpdate();
+	}
+}
+
+/**
+ * Reimplemented from AsyncUpdater. Once the background thread is idle, a held back configuration update is forwarded
+ * to the engine and the waiting request is handed to the background thread afterwards, so the engine is only ever
+ * reconfigured on the message thread and never while a request is executed. Then the queued events are delivered to the listeners.
+ */
+void EngineController::handleAsyncUpdate()
+{
+	auto configUpdatePending = false;
+	{
+		const ScopedLock sl(m_requestLock);
+		configUpdatePending = (m_configUpdatePending && m_releasedRequest == ER_None && !m_executing);
+		if (configUpdatePending)
+			m_configUpdatePending = false;
+	}
+
+	if (configUpdatePending)
+		m_engineWatcher.onConfigUpdated();
+
+	auto requestReleased = false;
+	{
+		const ScopedLock sl(m_requestLock);
+		if (m_pendingRequest != ER_None && m_releasedRequest == ER_None && !m_executing)
+		{
+			m_releasedRequest = m_pendingRequest;
+			m_pendingRequest = ER_None;
+			requestReleased = true;
+		}
+	}
+
+	if (requestReleased)
+		notify();
+
+	std::vector<EngineEvent> events;
+	{
+		const ScopedLock sl(m_eventLock);
+		events.swap(m_events);
+	}
+
+	for (auto const& engineEvent : events)
+	{
+		for (auto listener : Array<Listener*>(m_listeners))
+		{
+			if (engineEvent._finishedRequest == ER_None)
+				listener->engineStateChanged(engineEvent._state);
+			else
+				listener->engineRequestFinished(engineEvent._finishedRequest, engineEvent._succeeded, engineEvent._durationMs);
+		}
+	}
+}
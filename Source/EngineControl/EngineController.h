@@ -0,0 +1,164 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "ProcessingEngine/ProcessingEngineConfig.h"
+
+// Fwd. Declarations
+class ProcessingEngine;
+
+
+/**
+ * Class EngineController starts and stops the processing engine on a background thread, so binding sockets,
+ * opening midi devices and starting protocol threads never blocks the message thread.
+ * Requests are executed one after the other. A request that arrives while another one is executed replaces
+ * the one still waiting, so e.g. a burst of restarts results in a single restart. A waiting stop is only replaced
+ * by a start, never by a restart, so a stop followed by a restart leaves the engine stopped.
+ * The controller is registered as configuration watcher in place of the engine and holds configuration updates
+ * back while a request is waiting or executed, so the engine is never reconfigured and started at the same time.
+ * A held back update is forwarded on the message thread before the next request is handed to the background thread,
+ * so starts and restarts pick up the configuration that was dumped together with the request.
+ * State changes and finished requests are reported to the listeners on the message thread.
+ */
+class EngineController :	public ProcessingEngineConfig::Watcher,
+							private Thread,
+							private AsyncUpdater
+{
+public:
+	enum EngineState
+	{
+		ES_Stopped,		/**< The engine is not bridging. */
+		ES_Starting,	/**< The engine is being started on the background thread. */
+		ES_Running,		/**< The engine is bridging. */
+		ES_Stopping,	/**< The engine is being stopped on the background thread. */
+	};
+
+	enum EngineRequest
+	{
+		ER_None,		/**< No request. */
+		ER_Start,		/**< Start the engine if it is stopped. */
+		ER_Stop,		/**< Stop the engine if it is running. */
+		ER_Restart,		/**< Stop and start the engine again if it is running, to pick up a changed configuration. */
+	};
+
+	/**
+	 * Interface for objects that follow the engine state. All callbacks are made on the message thread.
+	 */
+	class Listener
+	{
+	public:
+		virtual ~Listener() {};
+
+		/**
+		 * Called when the engine entered a new state.
+		 *
+		 * @param state	The new engine state.
+		 */
+		virtual void engineStateChanged(EngineState state) = 0;
+
+		/**
+		 * Called when a request was executed.
+		 *
+		 * @param request		The executed request.
+		 * @param succeeded		True if the engine ended up in the requested state.
+		 * @param durationMs	The time executing the request took. For restarts, this is the time from stopping the engine until it was running with the new configuration.
+		 */
+		virtual void engineRequestFinished(EngineRequest request, bool succeeded, double durationMs) = 0;
+	};
+
+public:
+	EngineController(ProcessingEngine& engine);
+	~EngineController();
+
+	//==============================================================================
+	void RequestStart();
+	void RequestStop();
+	void RequestRestart();
+	void Shutdown();
+
+	//==============================================================================
+	EngineState GetState() const;
+	bool IsBusy() const;
+
+	//==============================================================================
+	void AddListener(Listener* listener);
+	void RemoveListener(Listener* listener);
+
+	//==============================================================================
+	void onConfigUpdated() override;
+
+private:
+	/**
+	 * Engine state change or finished request, queued by the background thread for the message thread.
+	 */
+	struct EngineEvent
+	{
+		EngineState		_state;				/**< The engine state at the time of the event. */
+		EngineRequest	_finishedRequest;	/**< The request that was finished, ER_None for plain state changes. */
+		bool			_succeeded;			/**< True if the finished request succeeded. */
+		double			_durationMs;		/**< The time the finished request took. */
+	};
+
+	void Request(EngineRequest request);
+	void ExecuteRequest(EngineRequest request);
+	bool IsBusyLocked() const;
+	bool StartEngine();
+	void StopEngine();
+	void SetState(EngineState state);
+	void PostEvent(const EngineEvent& engineEvent);
+
+	void run() override;
+	void handleAsyncUpdate() override;
+
+private:
+	ProcessingEngine&						m_engine;				/**< The engine that is controlled. */
+	ProcessingEngineConfig::Watcher&		m_engineWatcher;		/**< The engine as configuration watcher, configuration updates are forwarded to. */
+	std::atomic<int>						m_state{ ES_Stopped };	/**< The current engine state. */
+
+	CriticalSection							m_requestLock;			/**< Lock for the request members, shared with the background thread. */
+	EngineRequest							m_pendingRequest;		/**< The request waiting to be handed to the background thread. */
+	EngineRequest							m_releasedRequest;		/**< The request handed to the background thread, not yet picked up. */
+	bool									m_executing;			/**< Flag to indicate that the background thread executes a request. */
+	bool									m_configUpdatePending;	/**< Flag to indicate that a configuration update was held back while a request was executed. */
+
+	CriticalSection							m_eventLock;			/**< Lock for the queued events, shared with the background thread. */
+	std::vector<EngineEvent>				m_events;				/**< Events waiting to be delivered on the message thread. */
+
+	Array<Listener*>						m_listeners;			/**< The listeners to report to. */
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EngineController)
+};
@@ -34,9 +34,10 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "LoggingWindow.h"
 
-#include "LoggingTarget_Interface.h"
 #include "MainRemoteProtocolBridgeComponent.h"
 #include "RemoteProtocolBridgeCommon.h"
+#include "TrafficLogging/LogLineFormatter.h"
+#include "TrafficLogging/TrafficLoggingConfig.h"
 
 #include "ProcessingEngine/ProtocolProcessor/OSCProtocolProcessor/OSCProtocolProcessor.h"
 #include "ProcessingEngine/ProtocolProcessor/OCAProtocolProcessor/OCAProtocolProcessor.h"
@@ -44,8 +45,6 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ProcessingEngine/ProtocolProcessor/MIDIProtocolProcessor/MIDIProtocolProcessor.h"
 
 
-constexpr int NODE = INT_MAX;
-
 //==============================================================================
 // Class PlotComponent
 //==============================================================================
@@ -54,15 +53,56 @@ constexpr int NODE = INT_MAX;
  */
 PlotComponent::PlotComponent()
 {
+	jassert(hStepping == PlotHistory::HC_FineStepMs);
+
 	m_hRange = hRange;
 	m_hStepping = hStepping;
 	m_vRange = vRange;
 
-	m_plotData[NODE].resize(m_hRange/m_hStepping);
-
-	/*fill plotdata with default zero*/
-	for (int i = 0; i < (m_hRange / m_hStepping); ++i)
-		m_plotData[NODE].at(i) = 0;
+	m_breakdown = PB_Protocol;
+	m_unit = PU_Messages;
+	m_stacked = false;
+
+	m_protocolBreakdown._msgCounters = std::make_unique<AtomicCounterArray>(protocolCountRange);
+	m_protocolBreakdown._byteCounters = std::make_unique<AtomicCounterArray>(protocolCountRange);
+	m_nodeBreakdown._msgCounters = std::make_unique<AtomicCounterArray>(nodeCountRange);
+	m_nodeBreakdown._byteCounters = std::make_unique<AtomicCounterArray>(nodeCountRange);
+	m_objectBreakdown._msgCounters = std::make_unique<AtomicCounterArray>(ROI_BridgingMAX);
+	m_objectBreakdown._byteCounters = std::make_unique<AtomicCounterArray>(ROI_BridgingMAX);
+
+	m_breakdownDrop = std::make_unique<ComboBox>();
+	m_breakdownDrop->addItem("Per protocol", PB_Protocol);
+	m_breakdownDrop->addItem("Per node", PB_Node);
+	m_breakdownDrop->addItem("Per object", PB_Object);
+	m_breakdownDrop->setSelectedId(m_breakdown, dontSendNotification);
+	m_breakdownDrop->addListener(this);
+	addAndMakeVisible(m_breakdownDrop.get());
+
+	m_unitDrop = std::make_unique<ComboBox>();
+	m_unitDrop->addItem("msg/s", PU_Messages);
+	m_unitDrop->addItem("bytes/s", PU_Bytes);
+	m_unitDrop->setSelectedId(m_unit, dontSendNotification);
+	m_unitDrop->addListener(this);
+	addAndMakeVisible(m_unitDrop.get());
+
+	m_stackButton = std::make_unique<TextButton>("Stacked");
+	m_stackButton->setColour(TextButton::buttonColourId, Colours::dimgrey);
+	m_stackButton->setColour(Label::textColourId, Colours::white);
+	m_stackButton->addListener(this);
+	addAndMakeVisible(m_stackButton.get());
+
+	// item ids are the time range in seconds
+	m_zoomDrop = std::make_unique<ComboBox>();
+	m_zoomDrop->addItem("20 s", 20);
+	m_zoomDrop->addItem("1 min", 60);
+	m_zoomDrop->addItem("5 min", 300);
+	m_zoomDrop->addItem("15 min", 900);
+	m_zoomDrop->addItem("1 h", 3600);
+	m_zoomDrop->addItem("4 h", 14400);
+	m_zoomDrop->addItem("12 h", 43200);
+	m_zoomDrop->setSelectedId(m_hRange / 1000, dontSendNotification);
+	m_zoomDrop->addListener(this);
+	addAndMakeVisible(m_zoomDrop.get());
 
 	startTimer(m_hStepping);
 }
@@ -76,57 +116,170 @@ PlotComponent::~PlotComponent()
 }
 
 /**
- * Method to increase the received message counter per current interval for given Node and Protocol.
- * Currently we simply sum up all protocol traffic per node.
+ * Method to increase the received message and payload byte counters per current interval for given Node, Protocol and Object.
+ * This is called on engine threads and only increases lock-free counters, the breakdowns are all maintained
+ * incrementally, so switching between them shows the complete history.
  *
- * @param NId	The node id the count shall be increased for
- * @param PId	The node protocol id the count shall be increased for
+ * @param NId		The node id the count shall be increased for
+ * @param PId		The node protocol id the count shall be increased for
+ * @param Id		The remote object id the count shall be increased for
+ * @param byteCount	The payload size of the message
  */
-void PlotComponent::IncreaseCount(NodeId NId, ProtocolId PId)
+void PlotComponent::IncreaseCount(NodeId NId, ProtocolId PId, RemoteObjectIdentifier Id, uint32 byteCount)
 {
-	ignoreUnused(NId);
-	m_currentMsgPerProtocol[PId]++;
-
-	if (!m_protocolPlotColours.count(int(PId)))
-	{
-		float r = float(rand()) / float(RAND_MAX);
-		float g = float(rand()) / float(RAND_MAX);
-		float b = float(rand()) / float(RAND_MAX);
-		float a = 170.0f;
-		m_protocolPlotColours[int(PId)] = Colour::fromFloatRGBA(r, g, b, a);
-	}
+	m_protocolBreakdown._msgCounters->Increase(int(PId));
+	m_protocolBreakdown._byteCounters->Increase(int(PId), byteCount);
+	m_nodeBreakdown._msgCounters->Increase(int(NId));
+	m_nodeBreakdown._byteCounters->Increase(int(NId), byteCount);
+	m_objectBreakdown._msgCounters->Increase(int(Id));
+	m_objectBreakdown._byteCounters->Increase(int(Id), byteCount);
 }
 
 /**
  * Reimplemented from Timer - called every timeout timer
- * We do the processing of count of messages per node during last interval into our plot data for next paint here.
+ * We do the processing of count of messages during last interval into our plot data for next paint here.
  */
 void PlotComponent::timerCallback()
 {
-	// accumulate all protocol msgs as well as handle individual protocol msg counts
-	int msgCount = 0;
-	for (const std::pair<ProtocolId, int> &msgCountPerProtocol : m_currentMsgPerProtocol)
+	// every breakdown covers all traffic, so the totals are taken from the protocol breakdown
+	uint64 msgCount = 0;
+	uint64 byteCount = 0;
+	TakeCounts(m_protocolBreakdown, msgCount, byteCount);
+
+	uint64 ignoredMsgCount = 0;
+	uint64 ignoredByteCount = 0;
+	TakeCounts(m_nodeBreakdown, ignoredMsgCount, ignoredByteCount);
+	TakeCounts(m_objectBreakdown, ignoredMsgCount, ignoredByteCount);
+
+	m_totalMsgData.Push(float(msgCount));
+	m_totalByteData.Push(float(byteCount));
+
+	UpdateVerticalRange();
+
+	repaint();
+}
+
+/**
+ * Helper method to get a breakdown by its enum value.
+ *
+ * @param breakdown	The breakdown to get.
+ * @return	The breakdown counters and plot data.
+ */
+PlotComponent::Breakdown& PlotComponent::GetBreakdown(PlotBreakdown breakdown)
+{
+	switch (breakdown)
 	{
-		if (m_plotData[int(msgCountPerProtocol.first)].size() != m_plotData[NODE].size())
-			m_plotData[int(msgCountPerProtocol.first)].resize(m_plotData[NODE].size());
+	case PB_Node:
+		return m_nodeBreakdown;
+	case PB_Object:
+		return m_objectBreakdown;
+	case PB_Protocol:
+	default:
+		return m_protocolBreakdown;
+	}
+}
+
+/**
+ * Helper method to take the counts of the last interval of a breakdown into its plot data.
+ * Taking the counts resets the counters at the same time.
+ *
+ * @param breakdown	The breakdown to process.
+ * @param msgCount	Is increased by the overall msg count of the breakdown.
+ * @param byteCount	Is increased by the overall payload byte count of the breakdown.
+ */
+void PlotComponent::TakeCounts(Breakdown& breakdown, uint64& msgCount, uint64& byteCount)
+{
+	msgCount += breakdown._msgCounters->TakeOverflowCount();
+	byteCount += breakdown._byteCounters->TakeOverflowCount();
 
-		std::vector<float> shiftedVector(m_plotData[int(msgCountPerProtocol.first)].begin() + 1, m_plotData[int(msgCountPerProtocol.first)].end());
-		m_plotData[int(msgCountPerProtocol.first)].swap(shiftedVector);
-		m_plotData[int(msgCountPerProtocol.first)].push_back(float(msgCountPerProtocol.second));
+	for (int i = 0; i < breakdown._msgCounters->GetSize(); ++i)
+	{
+		auto msgCountOfId = breakdown._msgCounters->TakeCount(i);
+		auto byteCountOfId = breakdown._byteCounters->TakeCount(i);
+		msgCount += msgCountOfId;
+		byteCount += byteCountOfId;
 
-		msgCount += msgCountPerProtocol.second;
+		if (msgCountOfId > 0 && std::none_of(breakdown._plots.begin(), breakdown._plots.end(), [i](const SeriesPlot& plot) { return plot._id == i; }))
+			AddSeriesPlot(breakdown, i);
 
-		m_currentMsgPerProtocol[msgCountPerProtocol.first] = 0;
+		for (auto& seriesPlot : breakdown._plots)
+		{
+			if (seriesPlot._id == i)
+			{
+				seriesPlot._msgData->Push(float(msgCountOfId));
+				seriesPlot._byteData->Push(float(byteCountOfId));
+				break;
+			}
+		}
 	}
+}
 
-	std::vector<float> shiftedVector(m_plotData[NODE].begin() + 1, m_plotData[NODE].end());
-	m_plotData[NODE].swap(shiftedVector);
-	m_plotData[NODE].push_back(float(msgCount));
+/**
+ * Helper method to adjust our vertical plotting range to have better visu when large peaks would get out of scope.
+ * Only the peaks within the currently shown time range are taken into account.
+ */
+void PlotComponent::UpdateVerticalRange()
+{
+	auto tier = PlotHistory::GetTierForRange(m_hRange);
+	auto bucketCount = m_hRange / PlotHistory::GetStepMs(tier);
+	auto const& totalData = (m_unit == PU_Bytes) ? m_totalByteData : m_totalMsgData;
 
-	// Adjust our vertical plotting range to have better visu when large peaks would get out of scope
-	m_vRange = int(round(std::max(float(vRange), *std::max_element(m_plotData[NODE].begin(), m_plotData[NODE].end()))));
+	m_vRange = int(round(std::max(float(vRange), totalData.GetMaxOfNewest(tier, bucketCount))));
+}
 
-	repaint();
+/**
+ * Helper method to add the plot data for an id that was seen for the first time.
+ * This is only called from the timer on message thread, so the colour assignment does
+ * not happen on the engine threads.
+ *
+ * @param breakdown	The breakdown to add the plot data to.
+ * @param id		The protocol, node or object id to add the plot data for.
+ */
+void PlotComponent::AddSeriesPlot(Breakdown& breakdown, int id)
+{
+	float r = float(rand()) / float(RAND_MAX);
+	float g = float(rand()) / float(RAND_MAX);
+	float b = float(rand()) / float(RAND_MAX);
+	float a = 170.0f;
+
+	SeriesPlot seriesPlot;
+	seriesPlot._id = id;
+	seriesPlot._colour = Colour::fromFloatRGBA(r, g, b, a);
+	seriesPlot._msgData = std::make_unique<PlotHistory>();
+	seriesPlot._byteData = std::make_unique<PlotHistory>();
+
+	breakdown._plots.push_back(std::move(seriesPlot));
+}
+
+/**
+ * Helper method to get the legend name of a series in the current breakdown.
+ *
+ * @param id	The protocol, node or object id of the series.
+ * @return	The legend name.
+ */
+String PlotComponent::GetSeriesName(int id) const
+{
+	switch (m_breakdown)
+	{
+	case PB_Node:
+		return "Node" + String(id);
+	case PB_Object:
+		return ProcessingEngineConfig::GetObjectShortDescription(static_cast<RemoteObjectIdentifier>(id));
+	case PB_Protocol:
+	default:
+		return "PId" + String(id);
+	}
+}
+
+/**
+ * Helper method to get the plot data of a series in the current unit.
+ *
+ * @param seriesPlot	The series to get the plot data of.
+ * @return	The msg or byte count history of the series.
+ */
+const PlotHistory& PlotComponent::GetPlotData(const SeriesPlot& seriesPlot) const
+{
+	return (m_unit == PU_Bytes) ? *seriesPlot._byteData : *seriesPlot._msgData;
 }
 
 /**
@@ -157,18 +310,22 @@ void PlotComponent::paint(Graphics &g)
 	g.setColour(getLookAndFeel().findColour(CodeEditorComponent::ColourIds::backgroundColourId));
 	g.fillRect(plotArea);
 
-	if(!m_plotData[NODE].empty())
+	// the finest history tier that covers the shown time range is plotted
+	auto tier = PlotHistory::GetTierForRange(m_hRange);
+	auto bucketCount = jlimit(0, PlotHistory::GetCapacity(tier), m_hRange / PlotHistory::GetStepMs(tier));
+
+	if(bucketCount > 1)
 	{
 		float plotOrigX		  = mxl;
 		float plotOrigY		  = float(mxl + plotHeight);
-		float plotStepWidthPx = float(plotWidth) / float((m_plotData[NODE].size() > 0 ? m_plotData[NODE].size() : 1) - 1);
+		float plotStepWidthPx = float(plotWidth) / float(bucketCount - 1);
 
 		g.setColour(getLookAndFeel().findColour(CodeEditorComponent::ColourIds::defaultTextColourId));
 		g.drawLine(Line<float>(plotOrigX, plotOrigY, plotOrigX, plotOrigY - plotHeight));
 		g.drawLine(Line<float>(plotOrigX, plotOrigY, plotOrigX + plotWidth, plotOrigY));
 
 		float vUserRange = float(m_vRange) * (float(hUserVisuStepping) / float(m_hStepping));
-		g.drawText("msg/s", Rectangle<float>(ms, mm, 3 * ml, ml), Justification::topLeft, true);
+		g.drawText(m_unit == PU_Bytes ? "bytes/s" : "msg/s", Rectangle<float>(ms, mm, 3 * ml, ml), Justification::topLeft, true);
 		g.drawText(String(vUserRange), Rectangle<float>(ms * 0.5f, ms + mxl, mxl - ms * 0.5f, mm), Justification::centred, true);
 		g.drawText(String(vUserRange * 0.5f), Rectangle<float>(ms * 0.5f, ms + plotOrigY - (plotHeight * 0.5f), mxl - ms * 0.5f, mm),
 				   Justification::centred, true);
@@ -179,67 +336,808 @@ void PlotComponent::paint(Graphics &g)
 		g.drawLine(Line<float>(plotOrigX - ms, plotOrigY - (plotHeight * 0.25f), plotOrigX, plotOrigY - (plotHeight * 0.25f)));
 		g.drawLine(Line<float>(plotOrigX - mm, plotOrigY, plotOrigX, plotOrigY));
 
-		int hTime = int(float(m_plotData[NODE].size()) * float(m_hStepping) * 0.001);
+		String hUnit = "s";
+		float hUnitMs = 1000.0f;
+		if (m_hRange >= 2 * 3600000)
+		{
+			hUnit = "h";
+			hUnitMs = 3600000.0f;
+		}
+		else if (m_hRange >= 2 * 60000)
+		{
+			hUnit = "min";
+			hUnitMs = 60000.0f;
+		}
+		float hTime = float(m_hRange) / hUnitMs;
 		g.drawText(String(hTime), Rectangle<float>(ms + plotOrigX, mm + plotOrigY, mxl, mm), Justification::bottomLeft, true);
 		g.drawText(String(hTime * 0.5f), Rectangle<float>(ms + plotOrigX + (plotWidth * 0.5f), mm + plotOrigY, mxl, mm), Justification::bottomLeft, true);
 		g.drawText(String(0), Rectangle<float>(ms + plotOrigX + plotWidth, mm + plotOrigY, mxl, mm), Justification::bottomLeft, true);
-		g.drawText("time (s)", Rectangle<float>(mxl + plotWidth - 2 * mxl, plotOrigY, 2 * ml, ml), Justification::bottomRight, true);
+		g.drawText("time (" + hUnit + ")", Rectangle<float>(mxl + plotWidth - 2 * mxl, plotOrigY, 2 * ml, ml), Justification::bottomRight, true);
 		g.drawLine(Line<float>(plotOrigX, plotOrigY, plotOrigX, plotOrigY + mm));
 		g.drawLine(Line<float>(plotOrigX + (plotWidth * 0.25f), plotOrigY, plotOrigX + (plotWidth * 0.25f), plotOrigY + ms));
 		g.drawLine(Line<float>(plotOrigX + (plotWidth * 0.5f), plotOrigY, plotOrigX + (plotWidth * 0.5f), plotOrigY + mm));
 		g.drawLine(Line<float>(plotOrigX + (plotWidth * 0.75f), plotOrigY, plotOrigX + (plotWidth * 0.75f), plotOrigY + ms));
 		g.drawLine(Line<float>(plotOrigX + plotWidth, plotOrigY, plotOrigX + plotWidth, plotOrigY + mm));
 
-		float legendPosX = plotOrigX + mxl;
-		g.drawText("Total", Rectangle<float>(legendPosX, mm, 2 * ml, mm), Justification::centred, true);
-		legendPosX += 2 * ml;
-		g.drawLine(Line<float>(legendPosX, mm + ms, legendPosX + ml, mm + ms));
-		legendPosX += 3 * ml;
-		for (const std::pair<int, Colour> &protoCol : m_protocolPlotColours)
-		{
-			g.setColour(protoCol.second);
-			g.drawText("PId"+String(protoCol.first), Rectangle<float>(legendPosX, mm, 2 * ml, mm), Justification::centred, true);
-			legendPosX += 2 * ml;
-			g.drawLine(Line<float>(legendPosX, mm + ms, legendPosX + ml, mm + ms));
-			legendPosX += 3 * ml;
-		}
+		auto const& seriesPlots = GetBreakdown(m_breakdown)._plots;
+
+		float legendPosX = plotOrigX + mxl;
+		g.drawText("Total", Rectangle<float>(legendPosX, mm, 2 * ml, mm), Justification::centred, true);
+		legendPosX += 2 * ml;
+		g.drawLine(Line<float>(legendPosX, mm + ms, legendPosX + ml, mm + ms));
+		legendPosX += 3 * ml;
+		for (auto const& seriesPlot : seriesPlots)
+		{
+			auto seriesName = GetSeriesName(seriesPlot._id);
+			auto seriesNameWidth = jmax(2 * ml, g.getCurrentFont().getStringWidthFloat(seriesName) + ms);
+
+			g.setColour(seriesPlot._colour);
+			g.drawText(seriesName, Rectangle<float>(legendPosX, mm, seriesNameWidth, mm), Justification::centred, true);
+			legendPosX += seriesNameWidth;
+			g.drawLine(Line<float>(legendPosX, mm + ms, legendPosX + ml, mm + ms));
+			legendPosX += 3 * ml;
+		}
+
+		float newPointX = 0;
+		float newPointY = 0;
+		float vFactor	= float(plotHeight) / float(m_vRange > 0 ? m_vRange : 1);
+
+		Path path;
+		auto plotSeries = [&](const PlotTimeSeries& plotData)
+		{
+			auto firstIndex = plotData.GetSize() - bucketCount;
+			path.startNewSubPath(Point<float>(plotOrigX, plotOrigY - plotData.Get(firstIndex) * vFactor));
+			for (int i = 1; i < bucketCount; ++i)
+			{
+				newPointX = plotOrigX + float(i) * plotStepWidthPx;
+				newPointY = plotOrigY - (plotData.Get(firstIndex + i) * vFactor);
+
+				path.lineTo(Point<float>(newPointX, newPointY));
+			}
+			g.strokePath(path, PathStrokeType(2));
+			path.closeSubPath();
+			path.clear();
+		};
+
+		if (m_stacked)
+		{
+			// Graph areas for individual series, each on top of the previous ones
+			m_stackLower.assign(static_cast<size_t>(bucketCount), 0.0f);
+			m_stackUpper.resize(static_cast<size_t>(bucketCount));
+			for (auto const& seriesPlot : seriesPlots)
+			{
+				auto const& plotData = GetPlotData(seriesPlot).GetAvg(tier);
+				auto firstIndex = plotData.GetSize() - bucketCount;
+				for (int i = 0; i < bucketCount; ++i)
+					m_stackUpper[static_cast<size_t>(i)] = m_stackLower[static_cast<size_t>(i)] + plotData.Get(firstIndex + i);
+
+				path.startNewSubPath(Point<float>(plotOrigX, plotOrigY - m_stackUpper[0] * vFactor));
+				for (int i = 1; i < bucketCount; ++i)
+					path.lineTo(Point<float>(plotOrigX + float(i) * plotStepWidthPx, plotOrigY - m_stackUpper[static_cast<size_t>(i)] * vFactor));
+				for (int i = bucketCount - 1; i >= 0; --i)
+					path.lineTo(Point<float>(plotOrigX + float(i) * plotStepWidthPx, plotOrigY - m_stackLower[static_cast<size_t>(i)] * vFactor));
+				path.closeSubPath();
+
+				g.setColour(seriesPlot._colour.withMultipliedAlpha(0.6f));
+				g.fillPath(path);
+				path.clear();
+
+				m_stackLower.swap(m_stackUpper);
+			}
+		}
+		else
+		{
+			//Graph curve colour for individual series
+			for (auto const& seriesPlot : seriesPlots)
+			{
+				g.setColour(seriesPlot._colour);
+				plotSeries(GetPlotData(seriesPlot).GetAvg(tier));
+			}
+		}
+
+		// Graph curve colour for accumulated data, with the min/max band of the downsampled buckets
+		auto const& totalData = (m_unit == PU_Bytes) ? m_totalByteData : m_totalMsgData;
+		g.setColour(getLookAndFeel().findColour(CodeEditorComponent::ColourIds::defaultTextColourId));
+		if (tier != PlotHistory::HT_Fine)
+		{
+			auto const& minData = totalData.GetMin(tier);
+			auto const& maxData = totalData.GetMax(tier);
+			auto firstIndex = minData.GetSize() - bucketCount;
+
+			Path band;
+			band.startNewSubPath(Point<float>(plotOrigX, plotOrigY - maxData.Get(firstIndex) * vFactor));
+			for (int i = 1; i < bucketCount; ++i)
+				band.lineTo(Point<float>(plotOrigX + float(i) * plotStepWidthPx, plotOrigY - maxData.Get(firstIndex + i) * vFactor));
+			for (int i = bucketCount - 1; i >= 0; --i)
+				band.lineTo(Point<float>(plotOrigX + float(i) * plotStepWidthPx, plotOrigY - minData.Get(firstIndex + i) * vFactor));
+			band.closeSubPath();
+
+			g.setOpacity(0.25f);
+			g.fillPath(band);
+			g.setOpacity(1.0f);
+		}
+		plotSeries(totalData.GetAvg(tier));
+	}
+}
+
+/**
+ * Reimplemented from Component.
+ * The plot controls are placed in the top right corner.
+ */
+void PlotComponent::resized()
+{
+	Component::resized();
+
+	auto xPosition = getWidth() - UIS_Margin_m - UIS_ButtonWidth;
+	m_zoomDrop->setBounds(xPosition, UIS_Margin_s, UIS_ButtonWidth, UIS_ElmSize);
+	xPosition -= UIS_Margin_s + UIS_ButtonWidth;
+	m_stackButton->setBounds(xPosition, UIS_Margin_s, UIS_ButtonWidth, UIS_ElmSize);
+	xPosition -= UIS_Margin_s + UIS_ButtonWidth;
+	m_unitDrop->setBounds(xPosition, UIS_Margin_s, UIS_ButtonWidth, UIS_ElmSize);
+	xPosition -= UIS_Margin_s + UIS_OpenConfigWidth;
+	m_breakdownDrop->setBounds(xPosition, UIS_Margin_s, UIS_OpenConfigWidth, UIS_ElmSize);
+}
+
+/**
+ * Callback function for button clicks on buttons.
+ *
+ * @param button	The button object that was pressed.
+ */
+void PlotComponent::buttonClicked(Button* button)
+{
+	if (button == m_stackButton.get())
+	{
+		m_stacked = !m_stacked;
+
+		button->setColour(TextButton::buttonColourId, m_stacked ? Colours::lightgreen : Colours::dimgrey);
+		button->setColour(Label::textColourId, m_stacked ? Colours::dimgrey : Colours::white);
+
+		repaint();
+	}
+}
+
+/**
+ * Overloaded method called by ComboBox objects on change events.
+ *
+ * @param comboBox	The comboBox object that has been changed
+ */
+void PlotComponent::comboBoxChanged(ComboBox* comboBox)
+{
+	if (comboBox->getSelectedId() <= 0)
+		return;
+
+	if (comboBox == m_zoomDrop.get())
+		m_hRange = comboBox->getSelectedId() * 1000;
+	else if (comboBox == m_breakdownDrop.get())
+		m_breakdown = static_cast<PlotBreakdown>(comboBox->getSelectedId());
+	else if (comboBox == m_unitDrop.get())
+		m_unit = static_cast<PlotUnit>(comboBox->getSelectedId());
+
+	UpdateVerticalRange();
+	repaint();
+}
+
+
+//==============================================================================
+// Class LogRecordListComponent
+//==============================================================================
+/**
+ * Class constructor.
+ *
+ * @param store	The record store this list shows the contents of.
+ */
+LogRecordListComponent::LogRecordListComponent(const LogRecordStore& store)
+	: m_store(store)
+{
+	m_viewBeginIndex = m_store.GetBeginIndex();
+	m_viewEndIndex = m_store.GetEndIndex();
+	m_paused = false;
+
+	m_font = Font(Font::getDefaultMonospacedFontName(), 13.0f, Font::plain);
+
+	m_listBox = std::make_unique<ListBox>(String(), this);
+	m_listBox->setRowHeight(int(m_font.getHeight()) + UIS_Margin_s);
+	m_listBox->setColour(ListBox::backgroundColourId, getLookAndFeel().findColour(CodeEditorComponent::ColourIds::backgroundColourId));
+	addAndMakeVisible(m_listBox.get());
+}
+
+/**
+ * Destructor
+ */
+LogRecordListComponent::~LogRecordListComponent()
+{
+	m_listBox->setModel(nullptr);
+}
+
+/**
+ * Method to be called when the contents of the record store changed.
+ * If the view is not paused, the shown range is updated to the store contents
+ * and, if the last row was visible before, the view keeps sticking to the end.
+ */
+void LogRecordListComponent::UpdateContent()
+{
+	if (m_paused)
+		return;
+
+	auto stickToEnd = IsScrolledToEnd();
+
+	m_viewBeginIndex = m_store.GetBeginIndex();
+	m_viewEndIndex = m_store.GetEndIndex();
+	m_listBox->updateContent();
+
+	if (stickToEnd && getNumRows() > 0)
+		m_listBox->scrollToEnsureRowIsOnscreen(getNumRows() - 1);
+}
+
+/**
+ * Setter for the paused state. While paused, the shown range of records is frozen,
+ * while new records keep being collected in the store.
+ *
+ * @param paused	True to freeze the view, false to resume following the store contents.
+ */
+void LogRecordListComponent::SetPaused(bool paused)
+{
+	m_paused = paused;
+
+	if (!m_paused)
+		UpdateContent();
+}
+
+/**
+ * Getter for the paused state.
+ *
+ * @return	True if the view is currently frozen.
+ */
+bool LogRecordListComponent::IsPaused() const
+{
+	return m_paused;
+}
+
+/**
+ * Method to scroll to and select the row of a record. If the record is not part of the
+ * currently shown range, the range is extended to the complete store contents first.
+ *
+ * @param absoluteIndex	The absolute store index of the record to show.
+ */
+void LogRecordListComponent::ShowRecord(uint64 absoluteIndex)
+{
+	if (!m_store.Contains(absoluteIndex))
+		return;
+
+	if (absoluteIndex < m_viewBeginIndex || absoluteIndex >= m_viewEndIndex)
+	{
+		m_viewBeginIndex = m_store.GetBeginIndex();
+		m_viewEndIndex = m_store.GetEndIndex();
+		m_listBox->updateContent();
+	}
+
+	auto row = static_cast<int>(absoluteIndex - m_viewBeginIndex);
+	m_listBox->selectRow(row);
+	m_listBox->scrollToEnsureRowIsOnscreen(row);
+}
+
+/**
+ * Getter for the record of the currently selected row.
+ *
+ * @param absoluteIndex	The absolute store index of the selected record, if a row is selected.
+ * @return	True if a row is selected.
+ */
+bool LogRecordListComponent::GetSelectedIndex(uint64& absoluteIndex) const
+{
+	auto row = m_listBox->getSelectedRow();
+	if (row < 0)
+		return false;
+
+	absoluteIndex = m_viewBeginIndex + static_cast<uint64>(row);
+	return true;
+}
+
+/**
+ * Reimplemented from Component.
+ * The list covers the complete component area.
+ */
+void LogRecordListComponent::resized()
+{
+	Component::resized();
+
+	m_listBox->setBounds(getLocalBounds());
+}
+
+/**
+ * Helper method to check if the last row of the list is currently visible.
+ *
+ * @return	True if the list is scrolled to its end or if there is nothing to scroll.
+ */
+bool LogRecordListComponent::IsScrolledToEnd()
+{
+	auto viewport = m_listBox->getViewport();
+	if (!viewport || !viewport->getViewedComponent())
+		return true;
+
+	auto contentHeight = viewport->getViewedComponent()->getHeight();
+	auto visibleBottom = viewport->getViewPositionY() + viewport->getViewHeight();
+
+	return visibleBottom >= contentHeight - m_listBox->getRowHeight();
+}
+
+/**
+ * Reimplemented from ListBoxModel to return the number of rows in the current view range.
+ *
+ * @return	The number of rows.
+ */
+int LogRecordListComponent::getNumRows()
+{
+	return static_cast<int>(m_viewEndIndex - m_viewBeginIndex);
+}
+
+/**
+ * Reimplemented from ListBoxModel. This is only called for visible rows, so
+ * formatting the record into a log line is done here on demand.
+ *
+ * @param rowNumber		The row to paint.
+ * @param g				The graphics object to use for painting.
+ * @param width			The width of the row.
+ * @param height		The height of the row.
+ * @param rowIsSelected	True if the row is currently selected.
+ */
+void LogRecordListComponent::paintListBoxItem(int rowNumber, Graphics& g, int width, int height, bool rowIsSelected)
+{
+	if (rowIsSelected)
+		g.fillAll(getLookAndFeel().findColour(CodeEditorComponent::ColourIds::highlightColourId));
+
+	auto absoluteIndex = m_viewBeginIndex + static_cast<uint64>(rowNumber);
+	if (!m_store.Contains(absoluteIndex))
+		return;
+
+	g.setFont(m_font);
+	g.setColour(getLookAndFeel().findColour(CodeEditorComponent::ColourIds::defaultTextColourId));
+	g.drawText(FormatLogRecord(m_store.Get(absoluteIndex)), UIS_Margin_s, 0, width - 2 * UIS_Margin_s, height, Justification::centredLeft, false);
+}
+
+/**
+ * Helper method to create the human readable value string for a given record.
+ *
+ * @param record	The record to format the values of.
+ * @return	The values, each preceded by a space. Values that are not held inline are indicated by " ...".
+ */
+String LogRecordListComponent::FormatLogRecordValues(const LogRecord& record)
+{
+	auto& formatter = LogLineFormatter::GetThreadInstance();
+	formatter.FormatValues(record);
+
+	return formatter.ToString();
+}
+
+/**
+ * Helper method to create the human readable log line for a given record.
+ * The line is rendered into the reused buffer of the thread's LogLineFormatter,
+ * only the resulting String is allocated.
+ *
+ * @param record	The record to format.
+ * @return	The log line string.
+ */
+String LogRecordListComponent::FormatLogRecord(const LogRecord& record)
+{
+	auto& formatter = LogLineFormatter::GetThreadInstance();
+	formatter.FormatLine(record);
+
+	return formatter.ToString();
+}
+
+
+//==============================================================================
+// Class LogStateTableComponent
+//==============================================================================
+/**
+ * Class constructor.
+ *
+ * @param table	The state table to show.
+ */
+LogStateTableComponent::LogStateTableComponent(const LogStateTable& table)
+	: m_table(table),
+	m_font(Font::getDefaultMonospacedFontName(), 14.0f, Font::plain),
+	m_shownRowCount(0)
+{
+	m_tableListBox = std::make_unique<TableListBox>("StateTable", this);
+	m_tableListBox->setRowHeight(roundToInt(m_font.getHeight()) + 2);
+	m_tableListBox->setColour(ListBox::backgroundColourId, getLookAndFeel().findColour(CodeEditorComponent::ColourIds::backgroundColourId));
+
+	auto& header = m_tableListBox->getHeader();
+	header.addColumn("Node", STC_Node, 50);
+	header.addColumn("Protocol", STC_Protocol, 110);
+	header.addColumn("Object", STC_Object, 200);
+	header.addColumn("Ch", STC_Channel, 40);
+	header.addColumn("Rec", STC_Record, 40);
+	header.addColumn("Value", STC_Value, 220);
+	header.addColumn("Updates", STC_Updates, 70);
+	header.addColumn("Age [s]", STC_Age, 60);
+	header.setStretchToFitActive(true);
+
+	addAndMakeVisible(m_tableListBox.get());
+
+	startTimer(1000 / STC_FrameRateHz);
+}
+
+/**
+ * Destructor
+ */
+LogStateTableComponent::~LogStateTableComponent()
+{
+}
+
+/**
+ * Reimplemented from Component.
+ * The table covers the complete component area.
+ */
+void LogStateTableComponent::resized()
+{
+	Component::resized();
+
+	m_tableListBox->setBounds(getLocalBounds());
+}
+
+/**
+ * Reimplemented from TableListBoxModel to return the number of tracked objects.
+ *
+ * @return	The number of rows.
+ */
+int LogStateTableComponent::getNumRows()
+{
+	return m_shownRowCount;
+}
+
+/**
+ * Reimplemented from TableListBoxModel to paint the row background.
+ *
+ * @param g				The graphics object to use for painting.
+ * @param rowNumber		The row to paint.
+ * @param width			The width of the row.
+ * @param height		The height of the row.
+ * @param rowIsSelected	True if the row is currently selected.
+ */
+void LogStateTableComponent::paintRowBackground(Graphics& g, int rowNumber, int width, int height, bool rowIsSelected)
+{
+	ignoreUnused(rowNumber, width, height);
+
+	if (rowIsSelected)
+		g.fillAll(getLookAndFeel().findColour(CodeEditorComponent::ColourIds::highlightColourId));
+}
+
+/**
+ * Reimplemented from TableListBoxModel. This is only called for visible cells,
+ * so formatting the entry contents is done here on demand.
+ *
+ * @param g				The graphics object to use for painting.
+ * @param rowNumber		The row of the cell.
+ * @param columnId		The column of the cell.
+ * @param width			The width of the cell.
+ * @param height		The height of the cell.
+ * @param rowIsSelected	True if the row is currently selected.
+ */
+void LogStateTableComponent::paintCell(Graphics& g, int rowNumber, int columnId, int width, int height, bool rowIsSelected)
+{
+	ignoreUnused(rowIsSelected);
+
+	if (rowNumber < 0 || rowNumber >= m_table.GetSize())
+		return;
+
+	auto const& entry = m_table.Get(rowNumber);
+	auto const& record = entry._record;
+
+	String cellText;
+	switch (columnId)
+	{
+	case STC_Node:
+		cellText = String(static_cast<int>(record._nodeId));
+		break;
+	case STC_Protocol:
+		cellText = String(CharPointer_UTF8(LogLineFormatter::GetThreadInstance().FormatProtocol(record)));
+		break;
+	case STC_Object:
+		cellText = String(CharPointer_UTF8(LogLineFormatter::GetObjectName(PT_Invalid, record._objectId)));
+		break;
+	case STC_Channel:
+		cellText = String(static_cast<int>(record._channel));
+		break;
+	case STC_Record:
+		cellText = String(static_cast<int>(record._record));
+		break;
+	case STC_Value:
+		cellText = LogRecordListComponent::FormatLogRecordValues(record).trimStart();
+		break;
+	case STC_Updates:
+		cellText = String(entry._updateCount);
+		break;
+	case STC_Age:
+		cellText = String((Time::getMillisecondCounterHiRes() - record._timestamp) / 1000.0, 1);
+		break;
+	default:
+		break;
+	}
+
+	g.setFont(m_font);
+	g.setColour(getLookAndFeel().findColour(CodeEditorComponent::ColourIds::defaultTextColourId));
+	g.drawText(cellText, UIS_Margin_s, 0, width - 2 * UIS_Margin_s, height, Justification::centredLeft, true);
+}
+
+/**
+ * Reimplemented from Timer - called with the fixed frame rate.
+ * New rows are announced to the list and the visible rows are repainted.
+ */
+void LogStateTableComponent::timerCallback()
+{
+	if (!isShowing())
+		return;
+
+	if (m_shownRowCount != m_table.GetSize())
+	{
+		m_shownRowCount = m_table.GetSize();
+		m_tableListBox->updateContent();
+	}
+
+	m_tableListBox->repaint();
+}
+
+
+//==============================================================================
+// Class TrafficCaptureComponent
+//==============================================================================
+/**
+ * Class constructor.
+ *
+ * @param replayTarget	The record target replayed captures are delivered to.
+ */
+TrafficCaptureComponent::TrafficCaptureComponent(LogRecordTarget_Interface* replayTarget)
+	: m_replayTarget(replayTarget)
+{
+	m_captureButton = std::make_unique<TextButton>("Start capture");
+	addAndMakeVisible(m_captureButton.get());
+	m_captureButton->addListener(this);
+
+	m_captureStatusLabel = std::make_unique<Label>();
+	addAndMakeVisible(m_captureStatusLabel.get());
+
+	m_replayButton = std::make_unique<TextButton>("Replay...");
+	addAndMakeVisible(m_replayButton.get());
+	m_replayButton->addListener(this);
+
+	m_replaySpeedDrop = std::make_unique<ComboBox>();
+	addAndMakeVisible(m_replaySpeedDrop.get());
+	m_replaySpeedDrop->addItem("Original timing", RS_Original);
+	m_replaySpeedDrop->addItem("2x speed", RS_Double);
+	m_replaySpeedDrop->addItem("10x speed", RS_Tenfold);
+	m_replaySpeedDrop->addItem("Max. speed", RS_Max);
+	m_replaySpeedDrop->setSelectedId(RS_Original, dontSendNotification);
+
+	m_replayStatusLabel = std::make_unique<Label>();
+	addAndMakeVisible(m_replayStatusLabel.get());
+
+	UpdateControls();
+}
+
+/**
+ * Destructor
+ */
+TrafficCaptureComponent::~TrafficCaptureComponent()
+{
+	stopTimer();
+	m_replayer.Stop();
+	m_captureWriter.Stop();
+}
+
+/**
+ * Method to add a record to the capture.
+ * This is called on the logging sink worker thread and only queues the record for the capture writer thread.
+ *
+ * @param record	The record to capture, with its original timestamp.
+ */
+void TrafficCaptureComponent::CaptureRecord(const LogRecord& record)
+{
+	if (m_captureWriter.IsCapturing())
+		m_captureWriter.Push(record);
+}
+
+/**
+ * Getter for the replaying state.
+ *
+ * @return	True while a capture is being replayed.
+ */
+bool TrafficCaptureComponent::IsReplaying() const
+{
+	return m_replayer.IsReplaying();
+}
+
+/**
+ * Reimplemented from Component.
+ * Capture controls are placed in the first row, replay controls in the second.
+ */
+void TrafficCaptureComponent::resized()
+{
+	Component::resized();
+
+	auto labelWidth = getWidth() - 2 * UIS_Margin_m - UIS_OpenConfigWidth - UIS_Margin_m;
+
+	/*Capture row*/
+	int yPositionCapture = UIS_Margin_m;
+	m_captureButton->setBounds(UIS_Margin_m, yPositionCapture, UIS_OpenConfigWidth, UIS_ElmSize);
+	m_captureStatusLabel->setBounds(UIS_Margin_m + UIS_OpenConfigWidth + UIS_Margin_m, yPositionCapture, labelWidth, UIS_ElmSize);
+
+	/*Replay row*/
+	int yPositionReplay = yPositionCapture + UIS_ElmSize + UIS_Margin_m;
+	m_replayButton->setBounds(UIS_Margin_m, yPositionReplay, UIS_OpenConfigWidth, UIS_ElmSize);
+	m_replaySpeedDrop->setBounds(UIS_Margin_m + UIS_OpenConfigWidth + UIS_Margin_m, yPositionReplay, UIS_OpenConfigWidth, UIS_ElmSize);
+
+	int yPositionReplayStatus = yPositionReplay + UIS_ElmSize + UIS_Margin_m;
+	m_replayStatusLabel->setBounds(UIS_Margin_m + UIS_OpenConfigWidth + UIS_Margin_m, yPositionReplayStatus, labelWidth, UIS_ElmSize);
+}
+
+/**
+ * Callback function for button clicks on buttons.
+ *
+ * @param button	The button object that was pressed.
+ */
+void TrafficCaptureComponent::buttonClicked(Button* button)
+{
+	if (button == m_captureButton.get())
+	{
+		if (m_captureWriter.IsCapturing())
+			m_captureWriter.Stop();
+		else if (m_replayer.IsReplaying())
+			m_captureStatusLabel->setText("Capturing is not possible while replaying", dontSendNotification);
+		else if (!m_captureWriter.Start(GetDefaultCaptureFile()))
+			m_captureStatusLabel->setText("Failed to create capture file", dontSendNotification);
+	}
+	else if (button == m_replayButton.get())
+	{
+		if (m_replayer.IsReplaying())
+		{
+			m_replayer.Stop();
+		}
+		else
+		{
+			m_fileChooser = std::make_unique<FileChooser>("Select a traffic capture to replay", GetDefaultCaptureFile().getParentDirectory(), "*.rpbcap");
+			m_fileChooser->launchAsync(FileBrowserComponent::openMode | FileBrowserComponent::canSelectFiles, [this](const FileChooser& chooser)
+			{
+				auto captureFile = chooser.getResult();
+				if (captureFile.existsAsFile())
+					StartReplay(captureFile);
+			});
+		}
+	}
+
+	UpdateControls();
+}
+
+/**
+ * Helper method to get the replay speed factor for a given speed selection.
+ *
+ * @param speed	The speed selection.
+ * @return	The factor relative to the original timing, 0 for max. speed.
+ */
+double TrafficCaptureComponent::ReplaySpeedToFactor(ReplaySpeed speed)
+{
+	switch (speed)
+	{
+	case RS_Double:
+		return 2.0;
+	case RS_Tenfold:
+		return 10.0;
+	case RS_Max:
+		return 0.0;
+	case RS_Original:
+	default:
+		return 1.0;
+	}
+}
+
+/**
+ * Helper method to create a new capture file name in the default capture directory.
+ *
+ * @return	The file to capture to, named after the current time.
+ */
+File TrafficCaptureComponent::GetDefaultCaptureFile()
+{
+	auto captureDirectory = File::getSpecialLocation(File::userDocumentsDirectory).getChildFile("RemoteProtocolBridge").getChildFile("Captures");
+
+	return captureDirectory.getChildFile("Capture_" + Time::getCurrentTime().formatted("%Y-%m-%d_%H-%M-%S") + ".rpbcap");
+}
+
+/**
+ * Reimplemented from Timer - refreshes the capture and replay status while one of them is active.
+ */
+void TrafficCaptureComponent::timerCallback()
+{
+	UpdateControls();
+}
+
+/**
+ * Helper method to start replaying the given capture with the currently selected speed.
+ *
+ * @param captureFile	The capture file to replay.
+ */
+void TrafficCaptureComponent::StartReplay(const File& captureFile)
+{
+	// the capture may have been started while the file chooser was open
+	if (m_captureWriter.IsCapturing())
+	{
+		m_replayStatusLabel->setText("Replaying is not possible while capturing", dontSendNotification);
+		UpdateControls();
+		return;
+	}
+
+	auto speed = static_cast<ReplaySpeed>(m_replaySpeedDrop->getSelectedId());
+	if (!m_replayer.Start(captureFile, m_replayTarget, ReplaySpeedToFactor(speed)))
+		m_replayStatusLabel->setText("Not a valid traffic capture: " + captureFile.getFileName(), dontSendNotification);
+
+	UpdateControls();
+}
+
+/**
+ * Helper method to update button states and status labels.
+ * Capturing and replaying exclude each other, to not capture replayed traffic.
+ */
+void TrafficCaptureComponent::UpdateControls()
+{
+	auto capturing = m_captureWriter.IsCapturing();
+	auto replaying = m_replayer.IsReplaying();
 
-		float newPointX = 0;
-		float newPointY = 0;
-		float vFactor	= float(plotHeight) / float(m_vRange > 0 ? m_vRange : 1);
+	m_captureButton->setButtonText(capturing ? "Stop capture" : "Start capture");
+	m_captureButton->setColour(TextButton::buttonColourId, capturing ? Colours::orange : Colours::dimgrey);
+	m_captureButton->setColour(Label::textColourId, capturing ? Colours::dimgrey : Colours::white);
+	m_captureButton->setEnabled(!replaying);
 
-		Path path;	
-		for (const std::pair<int, std::vector<float>> pd : m_plotData)
-		{
-			if (pd.first == NODE)
-				// Graph curve colour for accumulated data	
-				g.setColour(getLookAndFeel().findColour(CodeEditorComponent::ColourIds::defaultTextColourId));
-			else
-				//Graph curve colour for individual protocols
-				g.setColour(m_protocolPlotColours.at(pd.first));
-
-			path.startNewSubPath(Point<float>(plotOrigX, plotOrigY - (m_plotData[pd.first].front()) * vFactor));
-			for (int i = 1; i < m_plotData[pd.first].size(); ++i)
-			{
-				newPointX = plotOrigX + float(i) * plotStepWidthPx;
-				newPointY = plotOrigY - (m_plotData[pd.first].at(i) * vFactor);
+	m_replayButton->setButtonText(replaying ? "Stop replay" : "Replay...");
+	m_replayButton->setColour(TextButton::buttonColourId, replaying ? Colours::lightgreen : Colours::dimgrey);
+	m_replayButton->setColour(Label::textColourId, replaying ? Colours::dimgrey : Colours::white);
+	m_replayButton->setEnabled(!capturing);
+	m_replaySpeedDrop->setEnabled(!replaying);
 
-				path.lineTo(Point<float>(newPointX, newPointY));
-			}
-			g.strokePath(path, PathStrokeType(2));
-			path.closeSubPath();
-			path.clear();
-		}
+	if (capturing || m_captureWriter.GetWrittenRecordCount() > 0)
+	{
+		String captureStatus;
+		captureStatus << m_captureWriter.GetCaptureFile().getFileName() << ": "
+			<< String(m_captureWriter.GetWrittenRecordCount()) << " records, "
+			<< String(m_captureWriter.GetDroppedCount()) << " dropped";
+		m_captureStatusLabel->setText(captureStatus, dontSendNotification);
+	}
+
+	if (replaying || m_replayer.GetReplayedRecordCount() > 0)
+	{
+		String replayStatus;
+		replayStatus << String(m_replayer.GetReplayedRecordCount()) << " records replayed ("
+			<< String(roundToInt(m_replayer.GetProgress() * 100.0)) << "%), "
+			<< String(roundToInt(m_replayer.GetReplayedRecordsPerSecond())) << " records/s";
+		m_replayStatusLabel->setText(replayStatus, dontSendNotification);
 	}
+
+	if ((capturing || replaying) && !isTimerRunning())
+		startTimer(ET_LoggingFlushRate);
+	else if (!capturing && !replaying && isTimerRunning())
+		stopTimer();
+}
+
+
+//==============================================================================
+// Class LoggingComponent::ReplayTarget
+//==============================================================================
+/**
+ * Class constructor.
+ *
+ * @param owner	The component replayed records are shown in.
+ */
+LoggingComponent::ReplayTarget::ReplayTarget(LoggingComponent& owner)
+	: m_owner(owner)
+{
 }
 
 /**
- * Reimplemented from Component.
- * Currently this only forwards to base implementation.
+ * Overloaded method to add a replayed record. This is called on the replay thread.
+ *
+ * @param record	The replayed record.
  */
-void PlotComponent::resized()
+void LoggingComponent::ReplayTarget::AddLogRecord(const LogRecord& record)
 {
-	Component::resized();
+	m_owner.AddReplayedRecord(record);
 }
 
 
@@ -250,28 +1148,132 @@ void PlotComponent::resized()
  * Class constructor.
  */
 LoggingComponent::LoggingComponent()
+	: m_replayTarget(*this),
+	m_recordRing(LC_RecordRingCapacity)
 {
 	m_parentListener = 0;
+	m_mode = LM_INVALID;
+	m_sinkRegistry = nullptr;
+	m_sinkId = LoggingSinkRegistry::SRC_InvalidSinkId;
 
-	m_textBox = std::make_unique<CodeEditorComponent>(m_doc, nullptr);
+	m_textBox = std::make_unique<LogRecordListComponent>(m_recordStore);
 	addChildComponent(m_textBox.get());
+	m_indexPrunedBeginIndex = m_recordStore.GetBeginIndex();
+	m_exportGathering = false;
+	m_exportBeginIndex = m_recordStore.GetBeginIndex();
+	m_exportNextIndex = m_exportBeginIndex;
+	m_exportEndIndex = m_exportBeginIndex;
+	m_exportFormat = LogRecordExporter::EF_Csv;
 
 	m_plotBox = std::make_unique<PlotComponent>();
 	addChildComponent(m_plotBox.get());
 
+	m_stateBox = std::make_unique<LogStateTableComponent>(m_stateTable);
+	addChildComponent(m_stateBox.get());
+
+	m_captureBox = std::make_unique<TrafficCaptureComponent>(&m_replayTarget);
+	addChildComponent(m_captureBox.get());
+
+	m_filterLabel = std::make_unique<Label>("FilterLabel", "Filter");
+	addAndMakeVisible(m_filterLabel.get());
+
+	std::map<LogRecordFilter::FilterDimension, String> filterHints = {
+		{ LogRecordFilter::FD_Node, "Nodes, e.g. 1-2" },
+		{ LogRecordFilter::FD_Protocol, "Protocols, e.g. 1,3" },
+		{ LogRecordFilter::FD_Object, "Objects, e.g. Sound Object Position XY" },
+		{ LogRecordFilter::FD_Channel, "Channels, e.g. 1-16" },
+		{ LogRecordFilter::FD_Record, "Records, e.g. 1" } };
+	for (auto const& filterHint : filterHints)
+	{
+		auto filterEdit = std::make_unique<TextEditor>();
+		filterEdit->setTextToShowWhenEmpty(filterHint.second, Colours::grey);
+		filterEdit->addListener(this);
+		addAndMakeVisible(filterEdit.get());
+		m_filterEdits[filterHint.first] = std::move(filterEdit);
+	}
+
+	m_ingestBudgetPercent = double(TLD_IngestBudgetPercent);
+	m_lastFlushTime = Time::getMillisecondCounterHiRes();
+	m_samplingStatsStart = m_lastFlushTime;
+	m_samplingOffered = 0;
+	m_samplingAccepted = 0;
+
+	m_samplingDrop = std::make_unique<ComboBox>();
+	m_samplingDrop->addItem("Log all", SM_All);
+	m_samplingDrop->addItem("Log 1 in 10", SM_OneIn10);
+	m_samplingDrop->addItem("Log 1 in 100", SM_OneIn100);
+	m_samplingDrop->addItem("Auto sampling", SM_Auto);
+	m_samplingDrop->setSelectedId(SM_All, dontSendNotification);
+	m_samplingDrop->addListener(this);
+	addAndMakeVisible(m_samplingDrop.get());
+
+	m_maxRateEdit = std::make_unique<TextEditor>();
+	m_maxRateEdit->setInputRestrictions(4, "0123456789");
+	m_maxRateEdit->setTextToShowWhenEmpty("Max. /s per object", Colours::grey);
+	m_maxRateEdit->addListener(this);
+	addAndMakeVisible(m_maxRateEdit.get());
+
+	m_samplingLabel = std::make_unique<Label>();
+	m_samplingLabel->setJustificationType(Justification::centred);
+	m_samplingLabel->setColour(Label::textColourId, Colours::orange);
+	addChildComponent(m_samplingLabel.get());
+
+	m_searchLabel = std::make_unique<Label>("SearchLabel", "Search");
+	addChildComponent(m_searchLabel.get());
+
+	m_searchEdit = std::make_unique<TextEditor>();
+	// without obj= every indexed combination is inspected per search step, so the hint leads with it
+	m_searchEdit->setTextToShowWhenEmpty("e.g. obj=Sound Object Position XY, ch=17, node=2, age=60 (fastest with obj=)", Colours::grey);
+	m_searchEdit->addListener(this);
+	addChildComponent(m_searchEdit.get());
+
+	m_searchPrevButton = std::make_unique<TextButton>("Prev");
+	m_searchPrevButton->addListener(this);
+	addChildComponent(m_searchPrevButton.get());
+
+	m_searchNextButton = std::make_unique<TextButton>("Next");
+	m_searchNextButton->addListener(this);
+	addChildComponent(m_searchNextButton.get());
+
 	m_LogModeDrop = std::make_unique<ComboBox>();
 	m_LogModeDrop->addListener(this);
 	addAndMakeVisible(m_LogModeDrop.get());
 	m_LogModeDrop->addItem(LogModeToString(LM_Text), LM_Text);
 	m_LogModeDrop->addItem(LogModeToString(LM_Graph), LM_Graph);
+	m_LogModeDrop->addItem(LogModeToString(LM_State), LM_State);
+	m_LogModeDrop->addItem(LogModeToString(LM_Capture), LM_Capture);
 	m_LogModeDrop->setColour(Label::textColourId, Colours::white);
 	m_LogModeDrop->setJustificationType(Justification::right);
 	SetLoggingMode(LM_Text);
 
+	m_pauseButton = std::make_unique<TextButton>("Pause");
+	addAndMakeVisible(m_pauseButton.get());
+	m_pauseButton->addListener(this);
+	m_pauseButton->setColour(TextButton::buttonColourId, Colours::dimgrey);
+	m_pauseButton->setColour(Label::textColourId, Colours::white);
+
+	m_exportButton = std::make_unique<TextButton>("Export");
+	addAndMakeVisible(m_exportButton.get());
+	m_exportButton->addListener(this);
+
+	m_exportFormatDrop = std::make_unique<ComboBox>();
+	m_exportFormatDrop->addItem("CSV", LogRecordExporter::EF_Csv);
+	m_exportFormatDrop->addItem("NumPy", LogRecordExporter::EF_NumPyColumns);
+	m_exportFormatDrop->setSelectedId(LogRecordExporter::EF_Csv, dontSendNotification);
+	addAndMakeVisible(m_exportFormatDrop.get());
+	UpdateExportButton();
+
+	m_statusLabel = std::make_unique<Label>();
+	addAndMakeVisible(m_statusLabel.get());
+	m_statusLabel->setJustificationType(Justification::centred);
+
 	m_closeButton = std::make_unique<TextButton>("Close");
 	addAndMakeVisible(m_closeButton.get());
 	m_closeButton->addListener(this);
 
+	// default retention, with the memory of the search index accounted
+	SetTrafficLoggingConfig(nullptr);
+
 	startTimer(ET_LoggingFlushRate);
 }
 
@@ -280,130 +1282,268 @@ LoggingComponent::LoggingComponent()
  */
 LoggingComponent::~LoggingComponent()
 {
+	m_exporter.Stop();
+
+	// stop replaying first, the replay thread delivers to this component
+	removeChildComponent(m_captureBox.get());
+	m_captureBox.reset();
+
 	removeChildComponent(m_textBox.get());
 	m_textBox.reset();
 }
 
 /**
- * Sets a logging message to logging queue
- *
- * @param messageString	The message text string to add to logging queue
+ * Reimplemented from Timer - called every timeout timer
+ * 
+ * Drains the record ring into the record store, applies the age limit of the
+ * retention policy and lets the message log view update its contents.
+ * Formatting is left to the view, that only does this for visible rows.
  */
-void LoggingComponent::AddMessage(String messageString)
+void LoggingComponent::timerCallback()
 {
-	if (m_mode==LM_Text)
+	auto flushStartTime = Time::getMillisecondCounterHiRes();
+
+	auto previousBeginIndex = m_recordStore.GetBeginIndex();
+	auto previousEndIndex = m_recordStore.GetEndIndex();
+
+	LogRecord record;
+	while (m_recordRing.Pop(record))
 	{
-		m_loggingQueue.push_back(messageString);
+		if (m_mode == LM_State)
+		{
+			m_stateTable.Update(record);
+		}
+		else
+		{
+			m_recordStore.Add(record);
+			m_recordIndex.Add(record, m_recordStore.GetEndIndex() - 1);
+		}
+	}
+
+	m_recordStore.EvictExpired(Time::getMillisecondCounterHiRes());
+
+	// searching skips evicted entries anyway, so the index is only pruned in larger steps
+	if (m_recordStore.GetBeginIndex() - m_indexPrunedBeginIndex >= LC_IndexPruneInterval)
+	{
+		m_recordIndex.Prune(m_recordStore.GetBeginIndex());
+		m_indexPrunedBeginIndex = m_recordStore.GetBeginIndex();
 	}
+
+	auto storeChanged = (previousBeginIndex != m_recordStore.GetBeginIndex() || previousEndIndex != m_recordStore.GetEndIndex());
+	if (storeChanged && m_textBox && m_mode == LM_Text)
+		m_textBox->UpdateContent();
+
+	GatherExportChunk();
+
+	auto flushEndTime = Time::getMillisecondCounterHiRes();
+	m_sampler.AdjustToLoad(flushEndTime - flushStartTime, flushStartTime - m_lastFlushTime);
+	m_lastFlushTime = flushStartTime;
+
+	UpdateSamplingIndicator();
+	UpdateExportButton();
+	UpdateStatus();
 }
 
 /**
- * Sets multiple logging messages to logging queue
- *
- * @param messageStrings	The message text strings to add to logging queue
+ * Helper method to show the share of messages that were logged over the last sampling statistics period.
+ * The indicator is only shown while messages are actually left out by sampling or rate limiting.
  */
-void LoggingComponent::AddMessages(const Array<String>& messageStrings)
+void LoggingComponent::UpdateSamplingIndicator()
 {
-	if (m_mode == LM_Text)
+	uint64 offeredCount = 0;
+	uint64 acceptedCount = 0;
+	m_sampler.TakeCounts(offeredCount, acceptedCount);
+	m_samplingOffered += offeredCount;
+	m_samplingAccepted += acceptedCount;
+
+	auto now = Time::getMillisecondCounterHiRes();
+	if (now - m_samplingStatsStart < LC_SamplingStatsPeriod)
+		return;
+
+	auto sampling = m_samplingAccepted < m_samplingOffered;
+	if (sampling)
 	{
-		for (const String& message : messageStrings)
-		{
-			m_loggingQueue.push_back(message);
-		}
+		auto sampledPercent = 100.0 * double(m_samplingAccepted) / double(m_samplingOffered);
+		m_samplingLabel->setText("sampled " + String(sampledPercent, sampledPercent < 10.0 ? 1 : 0) + "%", dontSendNotification);
 	}
+	m_samplingLabel->setVisible(sampling);
+
+	m_samplingStatsStart = now;
+	m_samplingOffered = 0;
+	m_samplingAccepted = 0;
 }
 
 /**
- * Reimplemented from Timer - called every timeout timer
- * 
- * Iterates over logging queue and adds all queued messages
- * to end of text area and terminates with a newline
+ * Helper method to refresh the status label with the current retention and drop counters.
  */
-void LoggingComponent::timerCallback()
+void LoggingComponent::UpdateStatus()
 {
-	if (m_textBox && m_mode == LM_Text)
+	if (!m_statusLabel)
+		return;
+
+	auto retainedMB = double(m_recordStore.GetRetainedBytes() + m_recordIndex.GetMemoryBytes()) / (1024.0 * 1024.0);
+
+	// records can be dropped in the queue of the logging sink as well as in the ring to the ui
+	auto droppedCount = m_recordRing.GetDroppedCount();
+	if (m_sinkRegistry)
+		droppedCount += m_sinkRegistry->GetSinkDroppedCount(m_sinkId);
+
+	String statusText;
+	if (m_mode == LM_State)
+		statusText << m_stateTable.GetSize() << " objects, "
+			<< String(m_stateTable.GetOverflowCount()) << " untracked, "
+			<< String(droppedCount) << " dropped";
+	else
+		statusText << m_recordStore.GetSize() << " retained (" << String(retainedMB, 1) << " MB), "
+			<< String(m_recordStore.GetEvictedCount()) << " evicted, "
+			<< String(droppedCount) << " dropped";
+
+	if (m_exportGathering)
 	{
-		m_textBox->moveCaretToEnd(false);
-		for (const String& message : m_loggingQueue)
-		{
-			m_textBox->insertTextAtCaret(message);
-			m_textBox->insertTextAtCaret("\n");
-		}
+		auto gatheredShare = static_cast<double>(m_exportNextIndex - m_exportBeginIndex) / static_cast<double>(jmax(uint64(1), m_exportEndIndex - m_exportBeginIndex));
+		statusText << ", preparing export " << String(roundToInt(gatheredShare * 100.0)) << "%";
+	}
+	else switch (m_exporter.GetState())
+	{
+	case LogRecordExporter::ES_Running:
+		statusText << ", exporting " << String(roundToInt(m_exporter.GetProgress() * 100.0)) << "%";
+		break;
+	case LogRecordExporter::ES_Finished:
+		statusText << ", exported " << String(m_exporter.GetRecordCount()) << " to " << m_exporter.GetTarget().getFileName();
+		break;
+	case LogRecordExporter::ES_Failed:
+		statusText << ", export failed";
+		break;
+	case LogRecordExporter::ES_Cancelled:
+		statusText << ", export cancelled";
+		break;
+	case LogRecordExporter::ES_Idle:
+	default:
+		break;
 	}
 
-	m_loggingQueue.clear();
+	m_statusLabel->setText(statusText, dontSendNotification);
 }
 
 /**
- * Overloaded method to add logging entry data to componentn
+ * Method to apply the traffic logging configuration to this component.
+ * This is the retention policy of the record history and the cpu budget of the automatic sampling.
  *
- * @param NId			The node id the logging data comes from
- * @param SenderPId		The protocol id of the protocol the data was received at
- * @param SenderType	The protocol type of the protocol that received the data
- * @param Id			The message id of the data
- * @param msgData		The actual data that is to be logged
+ * @param trafficLoggingXmlElement	The TRAFFICLOGGING element of the global configuration. Defaults are used if this is nullptr.
  */
-void LoggingComponent::AddLogData(NodeId NId, ProtocolId SenderPId, ProtocolType SenderType, RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData)
+void LoggingComponent::SetTrafficLoggingConfig(const XmlElement* trafficLoggingXmlElement)
 {
-	if (m_mode == LM_Text)
+	auto maxRecords = int(TLD_MaxRecords);
+	auto maxMemoryMB = int(TLD_MaxMemoryMB);
+	auto maxAgeSeconds = int(TLD_MaxAgeSeconds);
+	if (trafficLoggingXmlElement)
 	{
-		String objectString;
-		switch (SenderType)
-		{
-		case PT_OSCProtocol:
-			objectString += OSCProtocolProcessor::GetRemoteObjectString(Id) +
-				String::formatted(" | ch%d rec%d", msgData._addrVal._first, msgData._addrVal._second);
-			break;
-		case PT_OCAProtocol:
-			objectString += OCAProtocolProcessor::GetRemoteObjectString(Id) +
-				String::formatted(" | ch%d rec%d", msgData._addrVal._first, msgData._addrVal._second);
-			break;
-		case PT_RTTrPMProtocol:
-		case PT_MidiProtocol:
-			objectString += ProcessingEngineConfig::GetObjectShortDescription(Id) +
-				String::formatted(" | ch%d rec%d", msgData._addrVal._first, msgData._addrVal._second);
-			break;
-		default:
-			break;
-		}
+		maxRecords = trafficLoggingXmlElement->getIntAttribute(TrafficLoggingAttributes::MaxRecords, TLD_MaxRecords);
+		maxMemoryMB = trafficLoggingXmlElement->getIntAttribute(TrafficLoggingAttributes::MaxMemoryMB, TLD_MaxMemoryMB);
+		maxAgeSeconds = trafficLoggingXmlElement->getIntAttribute(TrafficLoggingAttributes::MaxAgeSeconds, TLD_MaxAgeSeconds);
+		m_ingestBudgetPercent = double(trafficLoggingXmlElement->getIntAttribute(TrafficLoggingAttributes::IngestBudgetPercent, TLD_IngestBudgetPercent));
+	}
+	if (m_sampler.IsAutomatic())
+		m_sampler.SetAutomatic(true, m_ingestBudgetPercent);
 
-		if (msgData._payload)
-		{
-			objectString += " |";
+	LogRecordStore::RetentionPolicy policy;
+	policy._maxRecordCount = jmax(1, maxRecords);
+	policy._maxMemoryBytes = int64(jmax(1, maxMemoryMB)) * 1024 * 1024;
+	policy._maxAgeMs = double(jmax(0, maxAgeSeconds)) * 1000.0;
+	// the search index holds a posting per retained record, the per key overhead comes on top of the limit
+	policy._indexBytesPerRecord = LogRecordIndex::IC_BytesPerEntry;
+	m_recordStore.SetRetentionPolicy(policy);
 
-			if (msgData._valType == ROVT_FLOAT)
-			{
-				float fvalue;
-				for (int i = 0; i < msgData._valCount; ++i)
-				{
-					fvalue = (static_cast<float*>(msgData._payload))[i];
-					objectString += String::formatted(" %f", fvalue);
-				}
-			}
-			else if (msgData._valType == ROVT_INT)
-			{
-				int ivalue;
-				for (int i = 0; i < msgData._valCount; ++i)
-				{
-					ivalue = (static_cast<int*>(msgData._payload))[i];
-					objectString += String::formatted(" %d", ivalue);
-				}
-			}
-		}
+	if (m_textBox)
+		m_textBox->UpdateContent();
+
+	UpdateStatus();
+}
+
+/**
+ * Overloaded method to add a log record to componentn.
+ * This is called on the logging sink worker thread, therefor the record is only checked against the filter
+ * and handed to the capture in capture mode or shown as required by the current mode otherwise.
+ *
+ * @param record	The record to be logged, with the timestamp and payload size of the original message.
+ */
+void LoggingComponent::AddLogRecord(const LogRecord& record)
+{
+	// the logging sink applies the same filter before queueing, this covers records that do not pass a sink
+	if (!m_filter.Matches(record._nodeId, record._protocolId, record._objectId, record._channel, record._record))
+		return;
+
+	// the mode may be changed on the message thread meanwhile, so it is read once per record
+	auto mode = m_mode.load();
+	if (mode == LM_Capture)
+	{
+		if (m_captureBox)
+			m_captureBox->CaptureRecord(record);
+	}
+	else
+		ShowRecord(record, mode, false);
+}
+
+/**
+ * Helper method to add a record of a capture replay. This is called on the replay thread.
+ * Replays are started in capture mode, so replayed records are never captured again, but shown
+ * in text, state and graph mode alike, to have them available in whichever mode is selected next.
+ *
+ * @param record	The replayed record.
+ */
+void LoggingComponent::AddReplayedRecord(const LogRecord& record)
+{
+	if (!m_filter.Matches(record._nodeId, record._protocolId, record._objectId, record._channel, record._record))
+		return;
 
-		String SenderName = ProcessingEngineConfig::ProtocolTypeToString(SenderType);
-		String logString;
-		logString << "Node" << (int)NId << "[In:" << SenderName << ":PId" << (int)SenderPId << "]: " << objectString;
+	ShowRecord(record, m_mode.load(), true);
+}
 
-		AddMessage(logString);
+/**
+ * Helper method to show a record that passed the filter.
+ * Records for text and state view are checked against the sampler and pushed to the lock-free record ring,
+ * formatting happens on message thread in ::timerCallback. The graph always gets all records.
+ *
+ * @param record		The record to show.
+ * @param mode			The logging mode that was current when the record was received.
+ * @param inAllModes	True to show the record in all views, false to only show it in the one of the given mode.
+ */
+void LoggingComponent::ShowRecord(const LogRecord& record, LoggingMode mode, bool inAllModes)
+{
+	if (inAllModes || mode == LM_Text || mode == LM_State)
+	{
+		if (m_sampler.Accept(record._objectId, record._channel, static_cast<uint32>(record._timestamp)))
+			m_recordRing.Push(record);
 	}
-	else if (m_mode == LM_Graph)
+
+	if (inAllModes || mode == LM_Graph)
 	{
 		if (m_plotBox)
-			m_plotBox->IncreaseCount(NId, SenderPId);
+			m_plotBox->IncreaseCount(record._nodeId, record._protocolId, record._objectId, record._payloadSize);
 	}
 }
 
+/**
+ * Method to set the logging sink this component is registered as. The filter bar selection is applied
+ * to the filter of the sink, so filtered out messages are not queued at all, and the records the sink
+ * had to drop are shown in the status.
+ *
+ * @param sinkRegistry	The registry the sink is registered at, nullptr if there is none.
+ * @param sinkId		The id of the sink.
+ */
+void LoggingComponent::SetLoggingSink(LoggingSinkRegistry* sinkRegistry, int sinkId)
+{
+	m_sinkRegistry = sinkRegistry;
+	m_sinkId = sinkId;
+
+	auto sinkFilter = m_sinkRegistry ? m_sinkRegistry->GetSinkFilter(m_sinkId) : nullptr;
+	if (sinkFilter)
+		for (auto const& filterEdit : m_filterEdits)
+			sinkFilter->SetFilter(filterEdit.first, filterEdit.second->getText());
+
+	UpdateStatus();
+}
+
 /**
  * Method to toggle the logging mode defined in 'LoggingMode' enum
  *
@@ -416,28 +1556,25 @@ void LoggingComponent::SetLoggingMode(LoggingMode mode)
 		m_mode = mode;
 		m_LogModeDrop->setSelectedId(mode);
 
-		switch (m_mode)
+		// the store is also filled outside of text mode, e.g. by a capture replay
+		if (m_textBox)
 		{
-		case LM_Text:
-			if (m_textBox)
-				m_textBox->setVisible(true);
-			if (m_plotBox)
-				m_plotBox->setVisible(false);
-			break;
-		case LM_Graph:
-			if (m_textBox)
-				m_textBox->setVisible(false);
-			if (m_plotBox)
-				m_plotBox->setVisible(true);
-			break;
-		case LM_INVALID:
-		default:
-			if (m_textBox)
-				m_textBox->setVisible(false);
-			if (m_plotBox)
-				m_plotBox->setVisible(false);
-			break;
+			m_textBox->setVisible(m_mode == LM_Text);
+			if (m_mode == LM_Text)
+				m_textBox->UpdateContent();
 		}
+		m_searchLabel->setVisible(m_mode == LM_Text);
+		m_searchEdit->setVisible(m_mode == LM_Text);
+		m_searchPrevButton->setVisible(m_mode == LM_Text);
+		m_searchNextButton->setVisible(m_mode == LM_Text);
+		if (m_plotBox)
+			m_plotBox->setVisible(m_mode == LM_Graph);
+		if (m_stateBox)
+			m_stateBox->setVisible(m_mode == LM_State);
+		if (m_captureBox)
+			m_captureBox->setVisible(m_mode == LM_Capture);
+
+		UpdateStatus();
 	}
 }
 
@@ -478,15 +1615,60 @@ void LoggingComponent::resized()
 	int yPositionModeDrop = windowHeight - UIS_ElmSize - UIS_Margin_m;
 	m_LogModeDrop->setBounds(xPositionModeDrop, yPositionModeDrop, UIS_OpenConfigWidth, UIS_ElmSize);
 
+	/*Pause Button*/
+	int xPositionPauseButton = xPositionModeDrop + UIS_OpenConfigWidth + UIS_Margin_m;
+	m_pauseButton->setBounds(xPositionPauseButton, yPositionModeDrop, UIS_ButtonWidth, UIS_ElmSize);
+
 	/*Close Button*/
 	int xPositionCloseButton = windowWidth - UIS_Margin_m - UIS_OpenConfigWidth;
 	int yPositionCloseButton = yPositionModeDrop;
 	m_closeButton->setBounds(xPositionCloseButton, yPositionCloseButton, UIS_OpenConfigWidth, UIS_ElmSize);
 
+	/*Sampling indicator*/
+	int xPositionSamplingLabel = xPositionCloseButton - UIS_Margin_m - UIS_ButtonWidth;
+	m_samplingLabel->setBounds(xPositionSamplingLabel, yPositionModeDrop, UIS_ButtonWidth, UIS_ElmSize);
+
+	/*Export Button and format*/
+	int xPositionExportButton = xPositionPauseButton + UIS_ButtonWidth + UIS_Margin_m;
+	m_exportButton->setBounds(xPositionExportButton, yPositionModeDrop, UIS_ButtonWidth, UIS_ElmSize);
+	int xPositionExportFormatDrop = xPositionExportButton + UIS_ButtonWidth + UIS_Margin_s;
+	m_exportFormatDrop->setBounds(xPositionExportFormatDrop, yPositionModeDrop, UIS_ButtonWidth, UIS_ElmSize);
+
+	/*Status Label*/
+	int xPositionStatusLabel = xPositionExportFormatDrop + UIS_ButtonWidth + UIS_Margin_m;
+	m_statusLabel->setBounds(xPositionStatusLabel, yPositionModeDrop, xPositionSamplingLabel - UIS_Margin_m - xPositionStatusLabel, UIS_ElmSize);
+
+	/*Filter bar*/
+	int yPositionFilter = yPositionModeDrop - UIS_ElmSize - UIS_Margin_m;
+	int xPositionMaxRateEdit = windowWidth - UIS_Margin_m - UIS_OpenConfigWidth;
+	int xPositionSamplingDrop = xPositionMaxRateEdit - UIS_Margin_s - UIS_OpenConfigWidth;
+	m_samplingDrop->setBounds(xPositionSamplingDrop, yPositionFilter, UIS_OpenConfigWidth, UIS_ElmSize);
+	m_maxRateEdit->setBounds(xPositionMaxRateEdit, yPositionFilter, UIS_OpenConfigWidth, UIS_ElmSize);
+	m_filterLabel->setBounds(UIS_Margin_m, yPositionFilter, UIS_ButtonWidth, UIS_ElmSize);
+	int xPositionFilterEdit = UIS_Margin_m + UIS_ButtonWidth + UIS_Margin_s;
+	int filterEditWidth = (xPositionSamplingDrop - UIS_Margin_m - xPositionFilterEdit) / jmax(1, int(m_filterEdits.size())) - UIS_Margin_s;
+	for (auto const& filterEdit : m_filterEdits)
+	{
+		filterEdit.second->setBounds(xPositionFilterEdit, yPositionFilter, filterEditWidth, UIS_ElmSize);
+		xPositionFilterEdit += filterEditWidth + UIS_Margin_s;
+	}
+
+	/*Search bar*/
+	int yPositionSearch = yPositionFilter - UIS_ElmSize - UIS_Margin_m;
+	m_searchLabel->setBounds(UIS_Margin_m, yPositionSearch, UIS_ButtonWidth, UIS_ElmSize);
+	int xPositionSearchNext = windowWidth - UIS_Margin_m - UIS_ButtonWidth;
+	int xPositionSearchPrev = xPositionSearchNext - UIS_Margin_s - UIS_ButtonWidth;
+	int xPositionSearchEdit = UIS_Margin_m + UIS_ButtonWidth + UIS_Margin_s;
+	m_searchEdit->setBounds(xPositionSearchEdit, yPositionSearch, xPositionSearchPrev - UIS_Margin_s - xPositionSearchEdit, UIS_ElmSize);
+	m_searchPrevButton->setBounds(xPositionSearchPrev, yPositionSearch, UIS_ButtonWidth, UIS_ElmSize);
+	m_searchNextButton->setBounds(xPositionSearchNext, yPositionSearch, UIS_ButtonWidth, UIS_ElmSize);
+
 	/*Logging Component*/
-	int loggingComponentHeight = yPositionCloseButton - UIS_Margin_m;
+	int loggingComponentHeight = yPositionSearch - UIS_Margin_m;
 	m_textBox->setBounds(Rectangle<int>(0, 0, windowWidth, loggingComponentHeight));
 	m_plotBox->setBounds(Rectangle<int>(0, 0, windowWidth, loggingComponentHeight));
+	m_stateBox->setBounds(Rectangle<int>(0, 0, windowWidth, loggingComponentHeight));
+	m_captureBox->setBounds(Rectangle<int>(0, 0, windowWidth, loggingComponentHeight));
 }
 
 /**
@@ -499,6 +1681,167 @@ void LoggingComponent::buttonClicked(Button* button)
 	{
 		m_parentListener->closeButtonPressed();
 	}
+	else if (button == m_pauseButton.get() && m_textBox)
+	{
+		m_textBox->SetPaused(!m_textBox->IsPaused());
+		UpdatePauseButton();
+	}
+	else if (button == m_exportButton.get())
+	{
+		if (IsExportBusy())
+			CancelExport();
+		else
+			StartExport();
+
+		UpdateExportButton();
+		UpdateStatus();
+	}
+	else if (button == m_searchPrevButton.get())
+	{
+		Search(true);
+	}
+	else if (button == m_searchNextButton.get())
+	{
+		Search(false);
+	}
+}
+
+/**
+ * Helper method to show the paused state of the message log view on the pause button.
+ */
+void LoggingComponent::UpdatePauseButton()
+{
+	auto paused = m_textBox && m_textBox->IsPaused();
+
+	m_pauseButton->setButtonText(paused ? "Resume" : "Pause");
+	m_pauseButton->setColour(TextButton::buttonColourId, paused ? Colours::orange : Colours::dimgrey);
+	m_pauseButton->setColour(Label::textColourId, paused ? Colours::dimgrey : Colours::white);
+}
+
+/**
+ * Helper method to show the export state on the export button. While exporting, the button cancels the export.
+ */
+void LoggingComponent::UpdateExportButton()
+{
+	auto exporting = IsExportBusy();
+
+	m_exportButton->setButtonText(exporting ? "Cancel" : "Export");
+	m_exportButton->setColour(TextButton::buttonColourId, exporting ? Colours::orange : Colours::dimgrey);
+	m_exportButton->setColour(Label::textColourId, exporting ? Colours::dimgrey : Colours::white);
+	m_exportFormatDrop->setEnabled(!exporting);
+}
+
+/**
+ * Helper method to export the currently retained records in the selected format.
+ * Only the range of the records is taken here. The records are copied out of the store in chunks
+ * on the following flush timer callbacks, so the message thread is never blocked by copying the
+ * whole store, and formatting and writing is done by the exporter thread. The export is named
+ * after the current time and placed in the Exports folder next to the traffic captures.
+ */
+void LoggingComponent::StartExport()
+{
+	m_exportGathering = true;
+	m_exportBeginIndex = m_recordStore.GetBeginIndex();
+	m_exportNextIndex = m_exportBeginIndex;
+	m_exportEndIndex = m_recordStore.GetEndIndex();
+	m_exportRecords.clear();
+	m_exportRecords.reserve(static_cast<size_t>(m_exportEndIndex - m_exportBeginIndex));
+
+	m_exportFormat = static_cast<LogRecordExporter::ExportFormat>(m_exportFormatDrop->getSelectedId());
+	auto exportDirectory = File::getSpecialLocation(File::userDocumentsDirectory).getChildFile("RemoteProtocolBridge").getChildFile("Exports");
+	m_exportTarget = exportDirectory.getChildFile("Traffic_" + Time::getCurrentTime().formatted("%Y-%m-%d_%H-%M-%S") + LogRecordExporter::GetFileExtension(m_exportFormat));
+
+	GatherExportChunk();
+}
+
+/**
+ * Helper method to copy the next chunk of the export range out of the store. Records that were evicted
+ * before they were copied are skipped. Once the range is complete, the records are handed to the exporter.
+ */
+void LoggingComponent::GatherExportChunk()
+{
+	if (!m_exportGathering)
+		return;
+
+	m_exportNextIndex = jmax(m_exportNextIndex, m_recordStore.GetBeginIndex());
+	auto chunkEndIndex = jmin(m_exportEndIndex, m_exportNextIndex + static_cast<uint64>(LC_ExportChunkSize));
+	for (; m_exportNextIndex < chunkEndIndex; ++m_exportNextIndex)
+		m_exportRecords.push_back(m_recordStore.Get(m_exportNextIndex));
+
+	if (m_exportNextIndex < m_exportEndIndex)
+		return;
+
+	m_exportGathering = false;
+	m_exporter.Start(std::move(m_exportRecords), m_exportTarget, m_exportFormat);
+	m_exportRecords = std::vector<LogRecord>();
+}
+
+/**
+ * Helper method to cancel the export, both while its records are gathered and while they are written.
+ */
+void LoggingComponent::CancelExport()
+{
+	if (m_exportGathering)
+	{
+		m_exportGathering = false;
+		m_exportRecords = std::vector<LogRecord>();
+	}
+	else
+	{
+		m_exporter.Stop();
+	}
+}
+
+/**
+ * Helper method to check if an export is gathered or written.
+ *
+ * @return	True while an export is in progress.
+ */
+bool LoggingComponent::IsExportBusy() const
+{
+	return m_exportGathering || m_exporter.IsExporting();
+}
+
+/**
+ * Helper method to jump to the previous or next record matching the search bar query,
+ * relative to the selected row. Without a selection, backwards search starts at the newest record.
+ * The view is paused on a match, so the found row stays in place while new records arrive.
+ *
+ * @param backwards	True to search towards older records, false towards newer ones.
+ */
+void LoggingComponent::Search(bool backwards)
+{
+	if (!m_textBox || !m_searchEdit)
+		return;
+
+	LogRecordIndex::Query query;
+	uint64 foundIndex = 0;
+	auto found = false;
+	if (LogRecordIndex::ParseQuery(m_searchEdit->getText(), query))
+	{
+		uint64 selectedIndex = 0;
+		auto hasSelection = m_textBox->GetSelectedIndex(selectedIndex);
+		if (backwards)
+			found = m_recordIndex.FindPrevious(m_recordStore, query, hasSelection ? selectedIndex : m_recordStore.GetEndIndex(), foundIndex);
+		else
+			found = m_recordIndex.FindNext(m_recordStore, query, hasSelection ? selectedIndex + 1 : m_recordStore.GetBeginIndex(), foundIndex);
+	}
+
+	if (found)
+	{
+		m_searchEdit->removeColour(TextEditor::outlineColourId);
+		m_searchEdit->removeColour(TextEditor::focusedOutlineColourId);
+
+		m_textBox->SetPaused(true);
+		UpdatePauseButton();
+		m_textBox->ShowRecord(foundIndex);
+	}
+	else
+	{
+		m_searchEdit->setColour(TextEditor::outlineColourId, Colours::red);
+		m_searchEdit->setColour(TextEditor::focusedOutlineColourId, Colours::red);
+	}
+	m_searchEdit->repaint();
 }
 
 /**
@@ -512,6 +1855,76 @@ void LoggingComponent::comboBoxChanged(ComboBox* comboBox)
 	{
 		SetLoggingMode((LoggingMode)m_LogModeDrop->getSelectedId());
 	}
+	else if (m_samplingDrop && (m_samplingDrop.get() == comboBox))
+	{
+		switch (m_samplingDrop->getSelectedId())
+		{
+		case SM_OneIn10:
+			m_sampler.SetSampleInterval(10);
+			break;
+		case SM_OneIn100:
+			m_sampler.SetSampleInterval(100);
+			break;
+		case SM_Auto:
+			m_sampler.SetAutomatic(true, m_ingestBudgetPercent);
+			break;
+		case SM_All:
+		default:
+			m_sampler.SetSampleInterval(1);
+			break;
+		}
+	}
+}
+
+/**
+ * Overloaded method called by TextEditor objects on textchange events.
+ * The filter bar input is compiled into the filter right away. Input that cannot
+ * be parsed is marked and leaves the previous selection of the dimension active.
+ * The max. rate input is applied to the sampler, an empty input removes the limit.
+ *
+ * @param textEdit	The textEdit object that has been changed
+ */
+void LoggingComponent::textEditorTextChanged(TextEditor& textEdit)
+{
+	if (&textEdit == m_maxRateEdit.get())
+	{
+		m_sampler.SetMaxObjectRate(textEdit.getText().getIntValue());
+		return;
+	}
+
+	for (auto const& filterEdit : m_filterEdits)
+	{
+		if (filterEdit.second.get() != &textEdit)
+			continue;
+
+		auto sinkFilter = m_sinkRegistry ? m_sinkRegistry->GetSinkFilter(m_sinkId) : nullptr;
+		if (sinkFilter)
+			sinkFilter->SetFilter(filterEdit.first, textEdit.getText());
+
+		if (m_filter.SetFilter(filterEdit.first, textEdit.getText()))
+		{
+			textEdit.removeColour(TextEditor::outlineColourId);
+			textEdit.removeColour(TextEditor::focusedOutlineColourId);
+		}
+		else
+		{
+			textEdit.setColour(TextEditor::outlineColourId, Colours::red);
+			textEdit.setColour(TextEditor::focusedOutlineColourId, Colours::red);
+		}
+		textEdit.repaint();
+	}
+}
+
+/**
+ * Overloaded method called by TextEditor objects on return key presses.
+ * In the search bar this jumps to the previous match, so repeated presses step back through the history.
+ *
+ * @param textEdit	The textEdit object the key was pressed in
+ */
+void LoggingComponent::textEditorReturnKeyPressed(TextEditor& textEdit)
+{
+	if (&textEdit == m_searchEdit.get())
+		Search(true);
 }
 
 /*
@@ -527,6 +1940,10 @@ String LoggingComponent::LogModeToString(LoggingMode lm)
 		return "Message Log";
 	case LM_Graph:
 		return "Traffic Graph";
+	case LM_State:
+		return "Current State";
+	case LM_Capture:
+		return "Traffic Capture";
 	case LM_INVALID:
 		return "Invalid";
 	default:
@@ -545,6 +1962,10 @@ LoggingComponent::LoggingMode LoggingComponent::LogModeFromString(String mode)
 		return LM_Text;
 	if (mode == LogModeToString(LM_Graph))
 		return LM_Graph;
+	if (mode == LogModeToString(LM_State))
+		return LM_State;
+	if (mode == LogModeToString(LM_Capture))
+		return LM_Capture;
 
 	return LM_INVALID;
 }
@@ -596,16 +2017,42 @@ void LoggingWindow::closeButtonPressed()
 }
 
 /**
- * 
+ * Overloaded method to add a log record.
+ * This simply forwards the record to the logging component.
+ *
+ * @param record	The record to be logged.
  */
-void LoggingWindow::AddLogData(NodeId NId, ProtocolId SenderPId, ProtocolType SenderType, RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData)
+void LoggingWindow::AddLogRecord(const LogRecord& record)
 {
 	if (m_loggingComponent)
 	{
-		m_loggingComponent->AddLogData(NId, SenderPId, SenderType, Id, msgData);
+		m_loggingComponent->AddLogRecord(record);
 	}
 }
 
+/**
+ * Proxy method to set the logging sink the window is registered as on the logging component.
+ *
+ * @param sinkRegistry	The registry the sink is registered at.
+ * @param sinkId		The id of the sink.
+ */
+void LoggingWindow::SetLoggingSink(LoggingSinkRegistry* sinkRegistry, int sinkId)
+{
+	if (m_loggingComponent)
+		m_loggingComponent->SetLoggingSink(sinkRegistry, sinkId);
+}
+
+/**
+ * Proxy method to apply the traffic logging configuration to the logging component.
+ *
+ * @param trafficLoggingXmlElement	The TRAFFICLOGGING element of the global configuration.
+ */
+void LoggingWindow::SetTrafficLoggingConfig(const XmlElement* trafficLoggingXmlElement)
+{
+	if (m_loggingComponent)
+		m_loggingComponent->SetTrafficLoggingConfig(trafficLoggingXmlElement);
+}
+
 /**
  * Method to add parent object as 'listener'.
  * This is done in a way JUCE uses to connect child-parent relations for handling 'signal' calls
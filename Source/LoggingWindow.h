@@ -36,8 +36,19 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <JuceHeader.h>
 
-#include "LoggingTarget_Interface.h"
+#include "LogRecordTarget_Interface.h"
 #include "ProcessingEngine/ProcessingEngine.h"
+#include "TrafficLogging/AtomicCounterArray.h"
+#include "TrafficLogging/LogRecordCapture.h"
+#include "TrafficLogging/LogRecordExporter.h"
+#include "TrafficLogging/LogRecordFilter.h"
+#include "TrafficLogging/LogRecordIndex.h"
+#include "TrafficLogging/LogRecordRing.h"
+#include "TrafficLogging/LogRecordSampler.h"
+#include "TrafficLogging/LogRecordStore.h"
+#include "TrafficLogging/LoggingSinkRegistry.h"
+#include "TrafficLogging/LogStateTable.h"
+#include "TrafficLogging/PlotHistory.h"
 
 // Fwd. Declarations
 class MainRemoteProtocolBridgeComponent;
@@ -46,16 +57,35 @@ class LoggingWindow;
 
 /**
  * Class PlotComponent visualizes message receive rate over time as a 2D plot.
+ * Traffic can be broken down into individual series per protocol, node or remote object,
+ * shown as message rate or payload data rate, and drawn individually or stacked.
  */
 class PlotComponent : public Component,
+	public Button::Listener,
+	public ComboBox::Listener,
 	private Timer
 {	
 	enum PlotConstants
 	{
-		hRange				= 20000,	// 20s on horizontal axis	
+		hRange				= 20000,	// 20s on horizontal axis by default, zoomable up to the history length	
 		hStepping			= 200,		// 200ms resolution
 		hUserVisuStepping	= 1000,		// User is presented with plot legend msg/s to have something more legible than 200ms
-		vRange				= 2			// 10 msg/s default on vertical axis (2 msg per 200ms interval)
+		vRange				= 2,		// 10 msg/s default on vertical axis (2 msg per 200ms interval)
+		protocolCountRange	= 256,		// Protocol ids that are counted and plotted individually
+		nodeCountRange		= 256		// Node ids that are counted and plotted individually
+	};
+
+	enum PlotBreakdown
+	{
+		PB_Protocol = 1,	/**< Individual series per protocol. */
+		PB_Node,			/**< Individual series per node. */
+		PB_Object,			/**< Individual series per remote object. */
+	};
+
+	enum PlotUnit
+	{
+		PU_Messages = 1,	/**< Plot the message rate. */
+		PU_Bytes,			/**< Plot the payload data rate. */
 	};
 
 public:
@@ -63,29 +93,219 @@ public:
 	~PlotComponent();
 
 	//==============================================================================
-	void IncreaseCount(NodeId NId, ProtocolId PId);
+	void IncreaseCount(NodeId NId, ProtocolId PId, RemoteObjectIdentifier Id, uint32 byteCount);
 
 	//==============================================================================
 	void paint(Graphics&) override;
 	void resized() override;
 
+	void buttonClicked(Button* button) override;
+	void comboBoxChanged(ComboBox* comboBox) override;
+
 private:
 	void timerCallback() override;
 
+	struct SeriesPlot
+	{
+		int								_id;		/**< The protocol, node or object id the plot data belongs to. */
+		Colour							_colour;	/**< Individual colour for the series plot. */
+		std::unique_ptr<PlotHistory>	_msgData;	/**< Msg count history of the series. */
+		std::unique_ptr<PlotHistory>	_byteData;	/**< Payload byte count history of the series. */
+	};
+
+	struct Breakdown
+	{
+		std::unique_ptr<AtomicCounterArray>	_msgCounters;	/**< Lock-free msg counters per id in current interval. */
+		std::unique_ptr<AtomicCounterArray>	_byteCounters;	/**< Lock-free payload byte counters per id in current interval. */
+		std::vector<SeriesPlot>				_plots;			/**< Plot data per id, in order of first appearance. */
+	};
+
+	Breakdown& GetBreakdown(PlotBreakdown breakdown);
+	void TakeCounts(Breakdown& breakdown, uint64& msgCount, uint64& byteCount);
+	void AddSeriesPlot(Breakdown& breakdown, int id);
+	String GetSeriesName(int id) const;
+	const PlotHistory& GetPlotData(const SeriesPlot& seriesPlot) const;
+	void UpdateVerticalRange();
+
 private:
 	int	m_hRange;		/**< Horizontal max plot value (value range) in ms. We use the range from left (0) to right (m_hRange) to plot data. */
 	int	m_hStepping;	/**< Horizontal step with in ms. */
 	int	m_vRange;		/**< Vertical max plot value (value range). We use the range from bottom (0) to top (m_vRange) where m_vRange 
 						*	is dynamically adjusted regarding incoming data to plot. */
 
-	std::map<ProtocolId, int>	m_currentMsgPerProtocol;	/**< Map to help counting messages per protocol in current interval. This is processed every timer callback to update plot data. */
+	Breakdown		m_protocolBreakdown;	/**< Counters and plot data per protocol. */
+	Breakdown		m_nodeBreakdown;		/**< Counters and plot data per node. */
+	Breakdown		m_objectBreakdown;		/**< Counters and plot data per remote object. */
+
+	PlotHistory		m_totalMsgData;			/**< Data for plotting the accumulated msg count history of all traffic. */
+	PlotHistory		m_totalByteData;		/**< Data for plotting the accumulated payload byte count history of all traffic. */
+
+	PlotBreakdown	m_breakdown;			/**< The breakdown of the individual series that are currently shown. */
+	PlotUnit		m_unit;					/**< The unit that is currently plotted. */
+	bool			m_stacked;				/**< Flag to indicate that individual series are stacked instead of drawn individually. */
 
-	std::map<int, std::vector<float>>	m_plotData;	/**< Data for plotting. Primitive vector of floats that represents the msg count per hor. step width. */
-	std::map<int, Colour> m_protocolPlotColours;	/** Individual colour for each protocol plot. */
+	std::vector<float>	m_stackLower;		/**< Reused buffer for the lower edge of a stacked series. */
+	std::vector<float>	m_stackUpper;		/**< Reused buffer for the upper edge of a stacked series. */
+
+	std::unique_ptr<ComboBox>	m_breakdownDrop;	/**< Dropdown for selection of the series breakdown. */
+	std::unique_ptr<ComboBox>	m_unitDrop;			/**< Dropdown for selection of the plotted unit. */
+	std::unique_ptr<TextButton>	m_stackButton;		/**< Button to toggle stacking of the individual series. */
+	std::unique_ptr<ComboBox>	m_zoomDrop;			/**< Dropdown for selection of the shown time range. */
 
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PlotComponent)
 };
 
+/**
+ * Class LogRecordListComponent shows the records of a LogRecordStore as a list of text lines.
+ * Only the rows that are currently visible are formatted and painted, so the cost of
+ * painting does not depend on the length of the logged history.
+ */
+class LogRecordListComponent : public Component,
+	private ListBoxModel
+{
+public:
+	LogRecordListComponent(const LogRecordStore& store);
+	~LogRecordListComponent();
+
+	//==============================================================================
+	void UpdateContent();
+	void SetPaused(bool paused);
+	bool IsPaused() const;
+	void ShowRecord(uint64 absoluteIndex);
+	bool GetSelectedIndex(uint64& absoluteIndex) const;
+
+	//==============================================================================
+	void resized() override;
+
+	//==============================================================================
+	static String FormatLogRecordValues(const LogRecord& record);
+
+private:
+	//==============================================================================
+	static String FormatLogRecord(const LogRecord& record);
+
+	//==============================================================================
+	int getNumRows() override;
+	void paintListBoxItem(int rowNumber, Graphics& g, int width, int height, bool rowIsSelected) override;
+
+	bool IsScrolledToEnd();
+
+private:
+	const LogRecordStore&		m_store;			/**< The store holding the records to show. */
+	std::unique_ptr<ListBox>	m_listBox;			/**< The list that does the row virtualization. */
+	Font						m_font;				/**< Font used for printing the log lines. */
+
+	uint64						m_viewBeginIndex;	/**< Absolute store index of the record shown in the first row. */
+	uint64						m_viewEndIndex;		/**< Absolute store index one past the record shown in the last row. */
+	bool						m_paused;			/**< Flag to indicate that the shown range is frozen. */
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LogRecordListComponent)
+};
+
+/**
+ * Class LogStateTableComponent shows the last received value per object of a LogStateTable.
+ * The visible rows are repainted at a fixed frame rate, independent of the message rate.
+ */
+class LogStateTableComponent : public Component,
+	private TableListBoxModel,
+	private Timer
+{
+	enum StateTableColumn
+	{
+		STC_Node = 1,	/**< Node the object was received in. */
+		STC_Protocol,	/**< Protocol the object was received on. */
+		STC_Object,		/**< Remote object description. */
+		STC_Channel,	/**< Channel addressing value. */
+		STC_Record,		/**< Record addressing value. */
+		STC_Value,		/**< Last received value(s). */
+		STC_Updates,	/**< Number of received updates. */
+		STC_Age,		/**< Time since the last update. */
+	};
+
+	enum StateTableConstants
+	{
+		STC_FrameRateHz = 10,	/**< Rate the visible rows are repainted with. */
+	};
+
+public:
+	LogStateTableComponent(const LogStateTable& table);
+	~LogStateTableComponent();
+
+	//==============================================================================
+	void resized() override;
+
+private:
+	//==============================================================================
+	int getNumRows() override;
+	void paintRowBackground(Graphics& g, int rowNumber, int width, int height, bool rowIsSelected) override;
+	void paintCell(Graphics& g, int rowNumber, int columnId, int width, int height, bool rowIsSelected) override;
+
+	void timerCallback() override;
+
+private:
+	const LogStateTable&			m_table;			/**< The table holding the state to show. */
+	std::unique_ptr<TableListBox>	m_tableListBox;		/**< The list that does the row virtualization. */
+	Font							m_font;				/**< Font used for printing the cell contents. */
+	int								m_shownRowCount;	/**< Number of rows the list was last updated with. */
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LogStateTableComponent)
+};
+
+/**
+ * Class TrafficCaptureComponent provides the controls to capture the logged traffic to a binary file
+ * and to replay such a capture into a logging target.
+ */
+class TrafficCaptureComponent : public Component,
+	public Button::Listener,
+	private Timer
+{
+	enum ReplaySpeed
+	{
+		RS_Original = 1,	/**< Replay with the timing the records were captured with. */
+		RS_Double,			/**< Replay twice as fast as captured. */
+		RS_Tenfold,			/**< Replay ten times as fast as captured. */
+		RS_Max,				/**< Replay as fast as the target accepts the records. */
+	};
+
+public:
+	TrafficCaptureComponent(LogRecordTarget_Interface* replayTarget);
+	~TrafficCaptureComponent();
+
+	//==============================================================================
+	void CaptureRecord(const LogRecord& record);
+
+	//==============================================================================
+	bool IsReplaying() const;
+
+	//==============================================================================
+	void resized() override;
+	void buttonClicked(Button* button) override;
+
+private:
+	static double ReplaySpeedToFactor(ReplaySpeed speed);
+	static File GetDefaultCaptureFile();
+
+	void timerCallback() override;
+
+	void StartReplay(const File& captureFile);
+	void UpdateControls();
+
+private:
+	LogRecordTarget_Interface*		m_replayTarget;			/**< The target replayed records are delivered to. */
+
+	LogRecordCaptureWriter			m_captureWriter;		/**< Writer that streams records to the capture file. */
+	LogRecordReplayer				m_replayer;				/**< Replayer that feeds a capture file to the replay target. */
+
+	std::unique_ptr<TextButton>		m_captureButton;		/**< Button to start/stop capturing. */
+	std::unique_ptr<Label>			m_captureStatusLabel;	/**< Label to show the capture file and counters. */
+	std::unique_ptr<TextButton>		m_replayButton;			/**< Button to select a capture file for replay/stop replaying. */
+	std::unique_ptr<ComboBox>		m_replaySpeedDrop;		/**< Dropdown for replay speed selection. */
+	std::unique_ptr<Label>			m_replayStatusLabel;	/**< Label to show the replay progress and rate. */
+	std::unique_ptr<FileChooser>	m_fileChooser;			/**< Chooser used to select the capture file to replay. */
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TrafficCaptureComponent)
+};
+
 /**
  * Class GlobalConfigComponent is a container used to hold the GUI controls for modifying the app configuration.
  */
@@ -93,33 +313,68 @@ class LoggingComponent : public Component,
 	public TextEditor::Listener,
 	public Button::Listener,
 	public ComboBox::Listener,
-	public LoggingTarget_Interface,
+	public LogRecordTarget_Interface,
 	private Timer
 {
 	enum LoggingMode
 	{
 		LM_Text = 1,	/**< Use a text window to print message data. */
 		LM_Graph,		/**< Use a graph to visualize message count/performance. */
+		LM_State,		/**< Use a table to show the last received value per object. */
+		LM_Capture,		/**< Capture message data to a binary file for later replay. */
 		LM_INVALID		/**< Invalid logging mode. */
 	};
 
+	enum SamplingMode
+	{
+		SM_All = 1,		/**< Log every message. */
+		SM_OneIn10,		/**< Log every 10th message. */
+		SM_OneIn100,	/**< Log every 100th message. */
+		SM_Auto,		/**< Lower the sampling rate as needed to keep the ingest within the cpu budget. */
+	};
+
+	/**
+	 * Record target the capture replay delivers to, as replayed records are handled
+	 * differently than the live records delivered to the component itself.
+	 */
+	class ReplayTarget : public LogRecordTarget_Interface
+	{
+	public:
+		ReplayTarget(LoggingComponent& owner);
+
+		void AddLogRecord(const LogRecord& record) override;
+
+	private:
+		LoggingComponent&	m_owner;	/**< The component replayed records are shown in. */
+	};
+
+	enum LoggingConstants
+	{
+		LC_RecordRingCapacity	= 16384,	/**< Number of records the ring between engine threads and ui can buffer between two flush timer callbacks. */
+		LC_IndexPruneInterval	= 4096,		/**< Number of evicted records after which the search index is pruned. */
+		LC_SamplingStatsPeriod	= 1000,		/**< Period in ms the sampled share shown in the sampling indicator is calculated over. */
+		LC_ExportChunkSize		= 16384,	/**< Number of records copied out of the store for an export per flush timer callback. */
+	};
+
 public:
 	LoggingComponent();
 	~LoggingComponent();
 
 
 	//==============================================================================
-	void AddLogData(NodeId NId, ProtocolId SenderPId, ProtocolType SenderType, RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData) override;
+	void AddLogRecord(const LogRecord& record) override;
 	void SetLoggingMode(LoggingMode mode);
 
 	//==============================================================================
-	void AddListener(LoggingWindow* listener);
+	void SetLoggingSink(LoggingSinkRegistry* sinkRegistry, int sinkId);
+
+	//==============================================================================
+	void SetTrafficLoggingConfig(const XmlElement* trafficLoggingXmlElement);
 
-private:
 	//==============================================================================
-	void AddMessage(String messageString);
-	void AddMessages(const Array<String>& messageStrings);
+	void AddListener(LoggingWindow* listener);
 
+private:
 	//==============================================================================
 	static String		LogModeToString(LoggingMode lm);
 	static LoggingMode	LogModeFromString(String mode);
@@ -130,23 +385,80 @@ private:
 
 	void buttonClicked(Button* button) override;
 	void comboBoxChanged(ComboBox* comboBox) override;
+	void textEditorTextChanged(TextEditor& textEdit) override;
+	void textEditorReturnKeyPressed(TextEditor& textEdit) override;
 
 	void timerCallback() override;
 
+	void AddReplayedRecord(const LogRecord& record);
+	void ShowRecord(const LogRecord& record, LoggingMode mode, bool inAllModes);
+
+	void UpdateStatus();
+	void UpdateSamplingIndicator();
+	void UpdatePauseButton();
+	void UpdateExportButton();
+	void Search(bool backwards);
+	void StartExport();
+	void GatherExportChunk();
+	void CancelExport();
+	bool IsExportBusy() const;
+
 private:
 	LoggingWindow*							m_parentListener;	/**< Parent that needs to be notified when this window self-destroys. */
 
-	std::unique_ptr<CodeEditorComponent>	m_textBox;			/**< The actual component to show log text within window. */
-	CodeDocument							m_doc;				/**< Document object used by codeeditorcomponent for content. */
+	LogRecordStore							m_recordStore;		/**< History of records that were received for logging. */
+	std::unique_ptr<LogRecordListComponent>	m_textBox;			/**< The actual component to show log text within window. */
+	LogRecordIndex							m_recordIndex;		/**< Search index over the records in m_recordStore. */
+	uint64									m_indexPrunedBeginIndex;	/**< Store begin index the search index was last pruned to. */
 
 	std::unique_ptr<PlotComponent>			m_plotBox;			/**< The actual component to show logging graph plot. */
 
-	LoggingMode								m_mode;				/**< The current logging UI mode to use. */
+	LogStateTable							m_stateTable;		/**< Last received record per object. */
+	std::unique_ptr<LogStateTableComponent>	m_stateBox;			/**< The component to show the state table. */
+
+	std::unique_ptr<TrafficCaptureComponent>	m_captureBox;	/**< The component to capture traffic to file and replay it. */
+	ReplayTarget								m_replayTarget;	/**< Target the capture replay delivers to. */
+
+	std::atomic<LoggingMode>				m_mode;				/**< The current logging UI mode to use. Set on the message thread, read by the sink worker and replay threads. */
+
+	std::unique_ptr<Label>											m_filterLabel;	/**< Label for the filter bar. */
+	std::map<LogRecordFilter::FilterDimension, std::unique_ptr<TextEditor>>	m_filterEdits;	/**< Filter bar text edits, one per filter dimension. */
+	LogRecordFilter													m_filter;		/**< Filter that is checked for every message before it is taken into logging. */
+
+	LoggingSinkRegistry*					m_sinkRegistry;		/**< Registry this component is registered at as queued sink, to apply the filter bar to the sink and show its drops. */
+	int										m_sinkId;			/**< Id of the sink this component is registered as, SRC_InvalidSinkId if none. */
+
+	LogRecordSampler						m_sampler;				/**< Sampling and per object rate limiting that is applied to messages that passed the filter. */
+	double									m_ingestBudgetPercent;	/**< Share of the flush period the automatic sampling keeps the ingest within. */
+	double									m_lastFlushTime;		/**< Time in ms of the previous flush timer callback. */
+	double									m_samplingStatsStart;	/**< Time in ms the current sampled share period started. */
+	uint64									m_samplingOffered;		/**< Count of messages checked by the sampler in the current period. */
+	uint64									m_samplingAccepted;		/**< Count of messages accepted by the sampler in the current period. */
+	std::unique_ptr<ComboBox>				m_samplingDrop;			/**< Dropdown for sampling mode selection. */
+	std::unique_ptr<TextEditor>				m_maxRateEdit;			/**< Edit for the max. logged updates per second per object and channel. */
+	std::unique_ptr<Label>					m_samplingLabel;		/**< Indicator for the share of messages that is logged while sampling is in effect. */
+
+	std::unique_ptr<Label>					m_searchLabel;		/**< Label for the search bar. */
+	std::unique_ptr<TextEditor>				m_searchEdit;		/**< Edit for the search query. */
+	std::unique_ptr<TextButton>				m_searchPrevButton;	/**< Button to jump to the previous match of the search query. */
+	std::unique_ptr<TextButton>				m_searchNextButton;	/**< Button to jump to the next match of the search query. */
 
 	std::unique_ptr<ComboBox>				m_LogModeDrop;		/**< Dropdown for logging mode selection. */
+	std::unique_ptr<TextButton>				m_pauseButton;		/**< Button to freeze/unfreeze the message log view. */
+	std::unique_ptr<TextButton>				m_exportButton;		/**< Button to start/cancel exporting the retained records. */
+	std::unique_ptr<ComboBox>				m_exportFormatDrop;	/**< Dropdown for export format selection. */
+	LogRecordExporter						m_exporter;			/**< Exporter that writes the retained records to disk in the background. */
+	std::vector<LogRecord>					m_exportRecords;	/**< Records copied out of the store so far for the export that is being gathered. */
+	bool									m_exportGathering;	/**< Flag to indicate that the records of an export are being copied out of the store. */
+	uint64									m_exportBeginIndex;	/**< Absolute store index the gathered export starts at. */
+	uint64									m_exportNextIndex;	/**< Absolute store index of the next record to copy for the export. */
+	uint64									m_exportEndIndex;	/**< Absolute store index the gathered export ends before. */
+	File									m_exportTarget;		/**< The file or directory the gathered export is written to. */
+	LogRecordExporter::ExportFormat			m_exportFormat;		/**< The format the gathered export is written in. */
+	std::unique_ptr<Label>					m_statusLabel;		/**< Label to show record and drop counts. */
 	std::unique_ptr<TextButton>				m_closeButton;		/**< Button to close the window - identical to Windows titlebar close functionality. */
 
-	std::vector<String>						m_loggingQueue;		/**< List of message strings to be printed on next flush timer callback. */
+	LogRecordRing							m_recordRing;		/**< Lock-free ring the engine threads push records into, to be processed on next flush timer callback. */
 
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LoggingComponent)
 };
@@ -155,7 +467,7 @@ private:
  * Class LoggingWindow provides a window for showing textbased logging entries
  */
 class LoggingWindow : public DialogWindow,
-	public LoggingTarget_Interface
+	public LogRecordTarget_Interface
 {
 public:
 	//==============================================================================
@@ -166,7 +478,11 @@ public:
 	~LoggingWindow();
 
 	//==============================================================================
-	void AddLogData(NodeId NId, ProtocolId SenderPId, ProtocolType SenderType, RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData) override;
+	void AddLogRecord(const LogRecord& record) override;
+
+	//==============================================================================
+	void SetLoggingSink(LoggingSinkRegistry* sinkRegistry, int sinkId);
+	void SetTrafficLoggingConfig(const XmlElement* trafficLoggingXmlElement);
 
 	//==============================================================================
 	void AddListener(MainRemoteProtocolBridgeComponent* listener);
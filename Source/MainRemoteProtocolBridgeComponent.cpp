@@ -36,9 +36,13 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "RemoteProtocolBridgeCommon.h"
 #include "NodeComponent.h"
+#include "NodeListComponent.h"
 #include "LoggingWindow.h"
 #include "ConfigComponents/GlobalConfigComponents/GlobalConfigComponents.h"
 #include "ProcessingEngine/ProcessingEngineConfig.h"
+#include "Configuration/ProcessingEngineConfigDiff.h"
+#include "Configuration/ConfigUpdateCoalescer.h"
+#include "TrafficLogging/TrafficStatistics.h"
 
 #include <Image_utils.h>
 
@@ -52,15 +56,27 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 MainRemoteProtocolBridgeComponent::MainRemoteProtocolBridgeComponent()
 {
 	m_config = std::make_unique<ProcessingEngineConfig>(ProcessingEngineConfig::getDefaultConfigFilePath());
+	m_configCoalescer = std::make_unique<ConfigUpdateCoalescer>(*m_config);
 
 	m_config->addDumper(this);
 
 	m_config->addWatcher(this);
-	m_config->addWatcher(&m_engine);
+	// the engine gets configuration updates through its controller, that holds them back while starting or stopping
+	m_engineController = std::make_unique<EngineController>(m_engine);
+	m_engineController->AddListener(this);
+	m_config->addWatcher(m_engineController.get());
 
 	m_ConfigDialog = 0;
 	m_LoggingDialog = 0;
 
+	m_statisticsCollector = std::make_unique<TrafficStatisticsCollector>();
+	m_loggingDialogSinkId = LoggingSinkRegistry::SRC_InvalidSinkId;
+	m_statisticsSinkId = LoggingSinkRegistry::SRC_InvalidSinkId;
+
+	/******************************************************/
+	m_NodeList = std::make_unique<NodeListComponent>(this);
+	addAndMakeVisible(m_NodeList.get());
+
 	/******************************************************/
     m_AddNodeButton = std::make_unique<DrawableButton>(String(), DrawableButton::ButtonStyle::ImageFitted);
 	m_AddNodeButton->addListener(this);
@@ -101,28 +117,29 @@ MainRemoteProtocolBridgeComponent::MainRemoteProtocolBridgeComponent()
 	m_EngineStartStopButton->setColour(TextButton::buttonColourId, Colours::dimgrey);
 	m_EngineStartStopButton->setColour(Label::textColourId, Colours::white);
 
+	m_ReconfigurationLabel = std::make_unique<Label>();
+	m_ReconfigurationLabel->setJustificationType(Justification::centredRight);
+	m_ReconfigurationLabel->setColour(Label::textColourId, Colours::grey);
+	addAndMakeVisible(m_ReconfigurationLabel.get());
+
 	if (!m_config->isValid())
 	{
-		m_config->triggerConfigurationDump();
+		m_configCoalescer->CommitDump(true);
 	}
 	else
 	{
 		m_config->triggerWatcherUpdate();
 	}
 
-	auto currentConfig = m_config->getConfigState();
-	auto globalConfigXmlElement = currentConfig->getChildByName(ProcessingEngineConfig::getTagName(ProcessingEngineConfig::TagID::GLOBALCONFIG));
-	if (globalConfigXmlElement)
+	UpdateConfigSnapshot();
+	auto globalConfig = m_configSnapshot ? m_configSnapshot->GetChildByName(ProcessingEngineConfig::getTagName(ProcessingEngineConfig::TagID::GLOBALCONFIG)) : nullptr;
+	if (globalConfig)
 	{
-		auto engineXmlElement = globalConfigXmlElement->getChildByName(ProcessingEngineConfig::getTagName(ProcessingEngineConfig::TagID::ENGINE));
-		if (engineXmlElement && engineXmlElement->getBoolAttribute(ProcessingEngineConfig::getAttributeName(ProcessingEngineConfig::AttributeID::AUTOSTART)))
+		auto engineConfig = globalConfig->GetChildByName(ProcessingEngineConfig::getTagName(ProcessingEngineConfig::TagID::ENGINE));
+		if (engineConfig && engineConfig->GetBoolAttribute(ProcessingEngineConfig::getAttributeName(ProcessingEngineConfig::AttributeID::AUTOSTART)))
 		{
-			if (!m_engine.IsRunning() && m_engine.Start())
-			{
-				m_EngineStartStopButton->setColour(TextButton::buttonColourId, Colours::lightgreen);
-				m_EngineStartStopButton->setColour(Label::textColourId, Colours::dimgrey);
-				m_EngineStartStopButton->setButtonText("Stop Engine");
-			}
+			if (m_engineController->GetState() == EngineController::ES_Stopped)
+				StartEngine();
 		}
 	}
 }
@@ -132,73 +149,58 @@ MainRemoteProtocolBridgeComponent::MainRemoteProtocolBridgeComponent()
  */
 MainRemoteProtocolBridgeComponent::~MainRemoteProtocolBridgeComponent()
 {
-	if (m_engine.IsRunning())
-		m_engine.Stop();
+	// edits still waiting for the coalesce window must not get lost, the dump is done while the watchers,
+	// the engine and its logging sinks are all still alive
+	m_configCoalescer->Flush();
+
+	// shutdown is the one place that waits for the engine to stop
+	m_engineController->RemoveListener(this);
+	m_engineController->Shutdown();
+
+	// the sink registry is destroyed before the engine, so the engine must not log to it anymore
+	m_engine.SetLoggingEnabled(false);
+	m_engine.SetLoggingTarget(0);
+	m_loggingSinks.RemoveAllSinks();
+	m_statisticsCollector->Stop();
 }
 
 /**
  * Method to set up ui elements according to configuration contents.
+ * The node list is handed the node subtrees of the configuration snapshot. Its node components only update
+ * what changed, so a watcher update after editing one node leaves all other nodes untouched.
  */
 void MainRemoteProtocolBridgeComponent::onConfigUpdated()
 {
-	auto currentConfigState = m_config->getConfigState();
-    auto nodeIds = m_config->GetNodeIds();
-
-	// go through current ui node boxes to find out which ones need to be removed/destroyed
-	Array<NodeId> nodeIdsToRemove;
-	for (auto const & nodeBox : m_NodeBoxes)
-		if (!nodeIds.contains(nodeBox.first))
-			nodeIdsToRemove.add(nodeBox.first);
-
-	for(auto nodeId : nodeIdsToRemove)
-	{
-		if (m_NodeBoxes.count(nodeId) && m_NodeBoxes.at(nodeId))
-		{
-			removeChildComponent(m_NodeBoxes.at(nodeId).get());
-			m_NodeBoxes.erase(nodeId);
-		}
-	}
-
-	int requiredNodeAreaHeight = 0;
-
-	// now go through all node ids currently in config and create those nodes
-	// that do not already exist or simply update those that are present
-    for (auto nodeId : nodeIds)
-    {
-		if (m_NodeBoxes.count(nodeId) == 0)
-		{
-			auto node = std::make_unique<NodeComponent>(nodeId);
-			node->AddListener(this);
-			node->setText("Protocol Bridging Node Id" + String(nodeId));
-			addAndMakeVisible(node.get());
+	UpdateConfigSnapshot();
+	if (!m_configSnapshot)
+		return;
 
-			m_NodeBoxes[nodeId] = std::move(node);
-		}
-    }
+	auto nodeTagName = ProcessingEngineConfig::getTagName(ProcessingEngineConfig::TagID::NODE);
 
-	auto nodeXmlElement = currentConfigState->getChildByName(ProcessingEngineConfig::getTagName(ProcessingEngineConfig::TagID::NODE));
-	while (nodeXmlElement != nullptr)
-	{
-		auto nodeId = nodeXmlElement->getIntAttribute(ProcessingEngineConfig::getAttributeName(ProcessingEngineConfig::AttributeID::ID));
-		if (m_NodeBoxes.count(nodeId) > 0)
-		{
-			m_NodeBoxes.at(nodeId)->setStateXml(nodeXmlElement);
-			requiredNodeAreaHeight += m_NodeBoxes[nodeId]->GetCurrentRequiredHeight();
-		}
+	// only the nodes in view get a component, the list takes care of creating, recycling and updating them
+	std::vector<ConfigTree::Ptr> nodeConfigs;
+	for (auto i = 0; i < m_configSnapshot->GetNumChildren(); ++i)
+		if (m_configSnapshot->GetChild(i)->GetTagName() == nodeTagName)
+			nodeConfigs.push_back(m_configSnapshot->GetChild(i));
 
-		nodeXmlElement = nodeXmlElement->getNextElementWithTagName(ProcessingEngineConfig::getTagName(ProcessingEngineConfig::TagID::NODE));
-	}
+	m_NodeList->SetNodeConfigs(nodeConfigs);
 
-	auto globalConfigXmlElement = currentConfigState->getChildByName(ProcessingEngineConfig::getTagName(ProcessingEngineConfig::TagID::GLOBALCONFIG));
-	if (globalConfigXmlElement)
+	auto globalConfig = m_configSnapshot->GetChildByName(ProcessingEngineConfig::getTagName(ProcessingEngineConfig::TagID::GLOBALCONFIG));
+	if (globalConfig)
 	{
-		m_GlobalConfigXml = std::make_unique<XmlElement>(*globalConfigXmlElement);
+		m_GlobalConfig = globalConfig;
 
-		auto trafficLoggingXmlElement = globalConfigXmlElement->getChildByName(ProcessingEngineConfig::getTagName(ProcessingEngineConfig::TagID::TRAFFICLOGGING));
-		if (trafficLoggingXmlElement && trafficLoggingXmlElement->getBoolAttribute(ProcessingEngineConfig::getAttributeName(ProcessingEngineConfig::AttributeID::ALLOWED)))
+		auto trafficLoggingConfig = globalConfig->GetChildByName(ProcessingEngineConfig::getTagName(ProcessingEngineConfig::TagID::TRAFFICLOGGING));
+		if (trafficLoggingConfig && trafficLoggingConfig->GetBoolAttribute(ProcessingEngineConfig::getAttributeName(ProcessingEngineConfig::AttributeID::ALLOWED)))
 			addAndMakeVisible(m_TriggerOpenLoggingButton.get());
 		else
 			removeChildComponent(m_TriggerOpenLoggingButton.get());
+
+		auto trafficLoggingXmlElement = trafficLoggingConfig ? trafficLoggingConfig->CreateXml() : nullptr;
+		if (m_LoggingDialog)
+			m_LoggingDialog->SetTrafficLoggingConfig(trafficLoggingXmlElement.get());
+
+		SetTrafficStatisticsConfig(trafficLoggingXmlElement.get());
 	}
 
 #if defined JUCE_IOS ||  defined JUCE_ANDROID
@@ -210,10 +212,83 @@ void MainRemoteProtocolBridgeComponent::onConfigUpdated()
 	// For +- and logging/config/start buttons, add some additional height
 	int requiredGlobalControlsHeight = 2 * (UIS_ElmSize + UIS_Margin_m);
 
-	setSize(UIS_MainComponentWidth, requiredNodeAreaHeight + requiredGlobalControlsHeight);
+	// the window grows with the nodes up to a limit, beyond that the node list scrolls
+	setSize(UIS_MainComponentWidth, jmin(m_NodeList->GetRequiredHeight(), static_cast<int>(NodeListComponent::NLC_MaxAutoSizeHeight)) + requiredGlobalControlsHeight);
 #endif
 }
 
+/**
+ * Helper method to (re-)start or stop the headless statistics export according to the given
+ * TRAFFICLOGGING element. A running export is only restarted if its configuration changed.
+ *
+ * @param trafficLoggingXmlElement	The element to read the statistics export attributes from.
+ */
+void MainRemoteProtocolBridgeComponent::SetTrafficStatisticsConfig(const XmlElement* trafficLoggingXmlElement)
+{
+	auto format = TSEF_Off;
+	auto intervalMs = TLD_StatsExportIntervalSeconds * 1000;
+	auto exportFilePath = String();
+	if (trafficLoggingXmlElement)
+	{
+		format = static_cast<TrafficStatsExportFormat>(jlimit(int(TSEF_Off), int(TSEF_JsonLines), trafficLoggingXmlElement->getIntAttribute(TrafficLoggingAttributes::StatsExportFormat, TLD_StatsExportFormat)));
+		intervalMs = trafficLoggingXmlElement->getIntAttribute(TrafficLoggingAttributes::StatsExportIntervalSeconds, TLD_StatsExportIntervalSeconds) * 1000;
+		exportFilePath = trafficLoggingXmlElement->getStringAttribute(TrafficLoggingAttributes::StatsExportFile).trim();
+	}
+
+	auto exportFile = File::isAbsolutePath(exportFilePath) ? File(exportFilePath) : TrafficStatisticsCollector::GetDefaultExportFile(format);
+
+	if (format == TSEF_Off)
+	{
+		if (m_statisticsCollector->IsExporting())
+			m_statisticsCollector->Stop();
+	}
+	else if (!m_statisticsCollector->IsExportingWith(exportFile, format, intervalMs))
+	{
+		m_statisticsCollector->Start(exportFile, format, intervalMs);
+	}
+
+	UpdateLoggingSinks();
+}
+
+/**
+ * Helper method to register the logging sinks that match the current state and to install the sink
+ * registry as engine logging target while at least one sink is registered.
+ * The statistics collector only counts lock-free and is delivered to directly, while the logging
+ * dialog gets its own queue and worker, so a busy ui never stalls the engine threads.
+ */
+void MainRemoteProtocolBridgeComponent::UpdateLoggingSinks()
+{
+	if (m_statisticsCollector->IsExporting() && m_statisticsSinkId == LoggingSinkRegistry::SRC_InvalidSinkId)
+		m_statisticsSinkId = m_loggingSinks.AddDirectSink(m_statisticsCollector.get());
+	else if (!m_statisticsCollector->IsExporting() && m_statisticsSinkId != LoggingSinkRegistry::SRC_InvalidSinkId)
+	{
+		m_loggingSinks.RemoveSink(m_statisticsSinkId);
+		m_statisticsSinkId = LoggingSinkRegistry::SRC_InvalidSinkId;
+	}
+
+	if (m_LoggingDialog && m_loggingDialogSinkId == LoggingSinkRegistry::SRC_InvalidSinkId)
+	{
+		m_loggingDialogSinkId = m_loggingSinks.AddQueuedSink(m_LoggingDialog.get());
+		m_LoggingDialog->SetLoggingSink(&m_loggingSinks, m_loggingDialogSinkId);
+	}
+	else if (!m_LoggingDialog && m_loggingDialogSinkId != LoggingSinkRegistry::SRC_InvalidSinkId)
+	{
+		m_loggingSinks.RemoveSink(m_loggingDialogSinkId);
+		m_loggingDialogSinkId = LoggingSinkRegistry::SRC_InvalidSinkId;
+	}
+
+	if (m_loggingSinks.HasSinks())
+	{
+		m_engine.SetLoggingTarget(&m_loggingSinks);
+		m_engine.SetLoggingEnabled(true);
+	}
+	else
+	{
+		m_engine.SetLoggingEnabled(false);
+		m_engine.SetLoggingTarget(0);
+	}
+}
+
 /**
  * Method to allow access to internal engine.
  *
@@ -230,10 +305,7 @@ ProcessingEngine* MainRemoteProtocolBridgeComponent::GetEngine()
  */
 void MainRemoteProtocolBridgeComponent::performConfigurationDump()
 {
-	auto running = GetEngine()->IsRunning();
-	GetEngine()->Stop();
-
-	if (m_NodeBoxes.empty() || !m_GlobalConfigXml)
+	if (m_NodeList->GetNodeCount() == 0 || !m_GlobalConfig)
 	{
 		// Add a default node
 		auto defaultNodeXmlElement = ProcessingEngineConfig::GetDefaultNode();
@@ -244,19 +316,148 @@ void MainRemoteProtocolBridgeComponent::performConfigurationDump()
 	}
 	else
 	{
-		for (auto const & nodeKV : m_NodeBoxes)
+		// nodes without a component are shown as they are in the configuration, so there is nothing to dump for them
+		for (auto nodeComponent : m_NodeList->GetNodeComponents())
 		{
-			if (nodeKV.second)
+			if (nodeComponent)
 			{
-				m_config->setConfigState(nodeKV.second->createStateXml(), ProcessingEngineConfig::getAttributeName(ProcessingEngineConfig::AttributeID::ID));
+				m_config->setConfigState(nodeComponent->createStateXml(), ProcessingEngineConfig::getAttributeName(ProcessingEngineConfig::AttributeID::ID));
 			}
 		}
 
-		m_config->setConfigState(std::make_unique<XmlElement>(*m_GlobalConfigXml));
+		m_config->setConfigState(m_GlobalConfig->CreateXml());
 	}
 
-	if (running)
-		GetEngine()->Start();
+	ApplyConfigurationToEngine();
+}
+
+/**
+ * Helper method to update the shared snapshot of the configuration state.
+ * Subtrees that did not change since the last update keep being shared with the previous snapshot.
+ */
+void MainRemoteProtocolBridgeComponent::UpdateConfigSnapshot()
+{
+	auto configState = m_config->getConfigState();
+	m_configSnapshot = configState ? ConfigTree::FromXml(*configState, m_configSnapshot) : nullptr;
+}
+
+/**
+ * Helper method to request starting the engine and remember the configuration state it is started with.
+ * The engine is started in the background, the result is reported to engineRequestFinished.
+ */
+void MainRemoteProtocolBridgeComponent::StartEngine()
+{
+	UpdateConfigSnapshot();
+	m_runningConfigState = m_configSnapshot;
+
+	m_engineController->RequestStart();
+}
+
+/**
+ * Helper method to apply the configuration that was just dumped to a running engine.
+ * The new state is diffed against the one the engine was started with. The engine is only restarted
+ * if the change affects it, so e.g. editing traffic logging settings or dumping an unchanged ui
+ * keeps bridging untouched. What the change affected and the resulting downtime is reported on the
+ * main component and in the statistics export, for restarts once the engine is running again.
+ */
+void MainRemoteProtocolBridgeComponent::ApplyConfigurationToEngine()
+{
+	auto engineState = m_engineController->GetState();
+	if (engineState == EngineController::ES_Stopped || engineState == EngineController::ES_Stopping)
+		return;
+
+	UpdateConfigSnapshot();
+	ProcessingEngineConfigDiff diff(m_runningConfigState.get(), m_configSnapshot.get());
+	if (diff.IsEmpty())
+		return;
+
+	m_runningConfigState = m_configSnapshot;
+
+	if (diff.AffectsEngine())
+	{
+		// ProcessingEngine only supports starting and stopping all nodes at once
+		m_pendingReconfigurationText = "Applied " + diff.GetDescription();
+		m_ReconfigurationLabel->setText("Applying " + diff.GetDescription() + ", restarting engine", dontSendNotification);
+		m_engineController->RequestRestart();
+	}
+	else
+	{
+		m_statisticsCollector->RecordReconfiguration(false, 0.0);
+		m_ReconfigurationLabel->setText("Applied " + diff.GetDescription() + ", no restart", dontSendNotification);
+	}
+}
+
+/**
+ * Reimplemented from EngineController::Listener to show the engine state on the start/stop button
+ * and the running nodes on the node list.
+ *
+ * @param state	The new engine state.
+ */
+void MainRemoteProtocolBridgeComponent::engineStateChanged(EngineController::EngineState state)
+{
+	switch (state)
+	{
+	case EngineController::ES_Running:
+		m_EngineStartStopButton->setColour(TextButton::buttonColourId, Colours::lightgreen);
+		m_EngineStartStopButton->setColour(Label::textColourId, Colours::dimgrey);
+		break;
+	case EngineController::ES_Starting:
+	case EngineController::ES_Stopping:
+		m_EngineStartStopButton->setColour(TextButton::buttonColourId, Colours::orange);
+		m_EngineStartStopButton->setColour(Label::textColourId, Colours::dimgrey);
+		break;
+	case EngineController::ES_Stopped:
+	default:
+		m_EngineStartStopButton->setColour(TextButton::buttonColourId, Colours::dimgrey);
+		m_EngineStartStopButton->setColour(Label::textColourId, Colours::white);
+		break;
+	}
+
+	// the engine only reports on all nodes at once, so every node it was started with is running
+	Array<NodeId> runningNodeIds;
+	if (state == EngineController::ES_Running && m_runningConfigState)
+	{
+		auto nodeTagName = ProcessingEngineConfig::getTagName(ProcessingEngineConfig::TagID::NODE);
+		auto idAttributeName = ProcessingEngineConfig::getAttributeName(ProcessingEngineConfig::AttributeID::ID);
+		for (auto i = 0; i < m_runningConfigState->GetNumChildren(); ++i)
+			if (m_runningConfigState->GetChild(i)->GetTagName() == nodeTagName)
+				runningNodeIds.add(static_cast<NodeId>(m_runningConfigState->GetChild(i)->GetIntAttribute(idAttributeName)));
+	}
+	m_NodeList->SetRunningNodeIds(runningNodeIds);
+}
+
+/**
+ * Reimplemented from EngineController::Listener to report the result of an engine start, stop or restart.
+ * Restarts for configuration changes are recorded with their downtime.
+ *
+ * @param request		The executed request.
+ * @param succeeded		True if the engine ended up in the requested state.
+ * @param durationMs	The time executing the request took, for restarts the downtime until the engine was running with the new configuration.
+ */
+void MainRemoteProtocolBridgeComponent::engineRequestFinished(EngineController::EngineRequest request, bool succeeded, double durationMs)
+{
+	String engineText;
+	switch (request)
+	{
+	case EngineController::ER_Start:
+		engineText << (succeeded ? "Engine started in " : "Engine failed to start after ") << String(durationMs, 1) << " ms";
+		break;
+	case EngineController::ER_Stop:
+		engineText << "Engine stopped in " << String(durationMs, 1) << " ms";
+		break;
+	case EngineController::ER_Restart:
+		m_statisticsCollector->RecordReconfiguration(true, durationMs);
+		engineText << m_pendingReconfigurationText << ", " << String(durationMs, 1) << " ms downtime";
+		if (!succeeded)
+			engineText << ", engine failed to start";
+		m_pendingReconfigurationText.clear();
+		break;
+	case EngineController::ER_None:
+	default:
+		return;
+	}
+
+	m_ReconfigurationLabel->setText(engineText, dontSendNotification);
 }
 
 /**
@@ -288,6 +489,11 @@ void MainRemoteProtocolBridgeComponent::resized()
 		m_TriggerOpenLoggingButton->setBounds(windowWidth - 160, yPositionConfTrafButtons, UIS_ButtonWidth, UIS_ElmSize);
 	if (m_EngineStartStopButton)
 		m_EngineStartStopButton->setBounds(windowWidth - 80, yPositionConfTrafButtons, UIS_ButtonWidth, UIS_ElmSize);
+	if (m_ReconfigurationLabel)
+	{
+		int xPositionReconfigurationLabel = UIS_Margin_m + UIS_OpenConfigWidth + UIS_Margin_m;
+		m_ReconfigurationLabel->setBounds(xPositionReconfigurationLabel, yPositionConfTrafButtons, windowWidth - 160 - UIS_Margin_m - xPositionReconfigurationLabel, UIS_ElmSize);
+	}
 
 	/*Add/Remove Buttons*/
 	int yPositionAddRemButts = yPositionConfTrafButtons - UIS_ElmSize;
@@ -296,18 +502,9 @@ void MainRemoteProtocolBridgeComponent::resized()
 	if (m_RemoveNodeButton)
 		m_RemoveNodeButton->setBounds(windowWidth - 45, yPositionAddRemButts, UIS_ElmSize, UIS_ElmSize);
 
-	/*Dynamically sized nodes*/
-	int nodeAreaWidth = windowWidth - 2 * UIS_Margin_s;
-	int nodeAreaHeight = yPositionAddRemButts - UIS_Margin_m;
-    Array<NodeId> NIds = m_config->GetNodeIds();
-	int nodeCount = NIds.size();
-	int nodeHeight = nodeCount > 0 ? nodeAreaHeight / nodeCount : 0;
-    for (int i = 0; i < nodeCount; ++i)
-    {
-        NodeId NId = NIds[i];
-		if (m_NodeBoxes.count(NId) && m_NodeBoxes.at(NId))
-			m_NodeBoxes.at(NId)->setBounds(UIS_Margin_s, UIS_Margin_s + (i*nodeHeight), nodeAreaWidth, nodeHeight);
-    }
+	/*Node list, scrolls when the nodes do not fit*/
+	if (m_NodeList)
+		m_NodeList->setBounds(0, 0, windowWidth, yPositionAddRemButts - UIS_Margin_m + UIS_Margin_s);
 
 }
 
@@ -322,9 +519,11 @@ void MainRemoteProtocolBridgeComponent::buttonClicked(Button* button)
 {
 	if (button == m_AddNodeButton.get())
 	{
+		ConfigUpdateCoalescer::ScopedTransaction transaction;
+
 		m_config->setConfigState(ProcessingEngineConfig::GetDefaultNode(), ProcessingEngineConfig::getAttributeName(ProcessingEngineConfig::AttributeID::ID));
 		m_config->triggerWatcherUpdate();
-		m_config->triggerConfigurationDump();
+		m_configCoalescer->CommitDump(true);
 	}
 	else if (button == m_RemoveNodeButton.get())
 	{
@@ -333,7 +532,7 @@ void MainRemoteProtocolBridgeComponent::buttonClicked(Button* button)
 			auto configStateXml = m_config->getConfigState();
 			configStateXml->removeChildElement(configStateXml->getChildByAttribute(ProcessingEngineConfig::getAttributeName(ProcessingEngineConfig::AttributeID::ID), String(static_cast<int>(m_config->GetNodeIds().getLast()))), true);
 			m_config->resetConfigState(std::move(configStateXml));
-			m_config->triggerConfigurationDump();
+			m_configCoalescer->CommitDump(true);
 		}
 	}
 	else if (button == m_TriggerOpenConfigButton.get())
@@ -342,8 +541,9 @@ void MainRemoteProtocolBridgeComponent::buttonClicked(Button* button)
 		// which means we have to process edited data
 		if (m_ConfigDialog != 0)
 		{
-			m_GlobalConfigXml = m_ConfigDialog->createStateXml();
-			m_config->triggerConfigurationDump();
+			auto globalConfigXml = m_ConfigDialog->createStateXml();
+			m_GlobalConfig = globalConfigXml ? ConfigTree::FromXml(*globalConfigXml, m_GlobalConfig) : nullptr;
+			m_configCoalescer->CommitDump(true);
 			m_ConfigDialog.reset();
 
 			button->setColour(TextButton::buttonColourId, Colours::dimgrey);
@@ -364,7 +564,8 @@ void MainRemoteProtocolBridgeComponent::buttonClicked(Button* button)
             m_ConfigDialog->setResizeLimits(size.first, size.second, size.first, size.second);
 			m_ConfigDialog->setBounds(Rectangle<int>(getScreenBounds().getX() + getWidth(), getScreenBounds().getY(), size.first, size.second));
 #endif
-			m_ConfigDialog->setStateXml(m_GlobalConfigXml.get());
+			auto globalConfigXml = m_GlobalConfig ? m_GlobalConfig->CreateXml() : nullptr;
+			m_ConfigDialog->setStateXml(globalConfigXml.get());
 
 			button->setColour(TextButton::buttonColourId, Colours::lightblue);
 			button->setColour(Label::textColourId, Colours::dimgrey);
@@ -372,14 +573,15 @@ void MainRemoteProtocolBridgeComponent::buttonClicked(Button* button)
 	}
 	else if (button == m_TriggerOpenLoggingButton.get())
 	{
-		if (m_engine.IsLoggingEnabled())
+		if (m_LoggingDialog)
 		{
-			m_engine.SetLoggingEnabled(false);
-			m_engine.SetLoggingTarget(0);
+			// detach the window from the engine before it is destroyed
+			auto loggingDialog = std::move(m_LoggingDialog);
+			UpdateLoggingSinks();
+			loggingDialog.reset();
+
 			button->setColour(TextButton::buttonColourId, Colours::dimgrey);
 			button->setColour(Label::textColourId, Colours::white);
-
-			m_LoggingDialog.reset();
 		}
 		else
 		{
@@ -394,9 +596,11 @@ void MainRemoteProtocolBridgeComponent::buttonClicked(Button* button)
 #else
 			m_LoggingDialog->setBounds(Rectangle<int>(getScreenBounds().getX() + getWidth(), getScreenBounds().getY(), 800, 500));
 #endif
+			auto trafficLoggingConfig = m_GlobalConfig ? m_GlobalConfig->GetChildByName(ProcessingEngineConfig::getTagName(ProcessingEngineConfig::TagID::TRAFFICLOGGING)) : nullptr;
+			if (trafficLoggingConfig)
+				m_LoggingDialog->SetTrafficLoggingConfig(trafficLoggingConfig->CreateXml().get());
 
-			m_engine.SetLoggingEnabled(true);
-			m_engine.SetLoggingTarget(m_LoggingDialog.get());
+			UpdateLoggingSinks();
 
 			button->setColour(TextButton::buttonColourId, Colours::orange);
 			button->setColour(Label::textColourId, Colours::dimgrey);
@@ -404,24 +608,18 @@ void MainRemoteProtocolBridgeComponent::buttonClicked(Button* button)
 	}
 	else if (button == m_EngineStartStopButton.get())
 	{
-		if (m_engine.IsRunning())
+		// starting and stopping happens in the background, the button follows in engineStateChanged
+		auto engineState = m_engineController->GetState();
+		if (engineState == EngineController::ES_Running || engineState == EngineController::ES_Starting)
 		{
-			m_engine.Stop();
-			button->setColour(TextButton::buttonColourId, Colours::dimgrey);
-			button->setColour(Label::textColourId, Colours::white);
-			//button->setButtonText("Start Engine");
+			m_engineController->RequestStop();
 		}
 		else
 		{
 			// Get data from ui together to start the engine correctly.
-			m_config->triggerConfigurationDump();
+			m_configCoalescer->CommitDump(true);
 
-			if (m_engine.Start())
-			{
-				button->setColour(TextButton::buttonColourId, Colours::lightgreen);
-				button->setColour(Label::textColourId, Colours::dimgrey);
-				//button->setButtonText("Stop Engine");
-			}
+			StartEngine();
 		}
 	}
 }
@@ -439,8 +637,9 @@ void MainRemoteProtocolBridgeComponent::childWindowCloseTriggered(DialogWindow*
 	{
 		if (m_ConfigDialog != 0)
 		{
-			m_GlobalConfigXml = m_ConfigDialog->createStateXml();
-			m_config->triggerConfigurationDump();
+			auto globalConfigXml = m_ConfigDialog->createStateXml();
+			m_GlobalConfig = globalConfigXml ? ConfigTree::FromXml(*globalConfigXml, m_GlobalConfig) : nullptr;
+			m_configCoalescer->CommitDump(true);
 
 			if (m_TriggerOpenConfigButton)
 			{
@@ -453,18 +652,15 @@ void MainRemoteProtocolBridgeComponent::childWindowCloseTriggered(DialogWindow*
 	}
 	else if (childWindow == m_LoggingDialog.get())
 	{
-		if (m_engine.IsLoggingEnabled())
+		if (m_TriggerOpenLoggingButton)
 		{
-			m_engine.SetLoggingEnabled(false);
-			m_engine.SetLoggingTarget(0);
-
-			if (m_TriggerOpenLoggingButton)
-			{
-				m_TriggerOpenLoggingButton->setColour(TextButton::buttonColourId, Colours::dimgrey);
-				m_TriggerOpenLoggingButton->setColour(Label::textColourId, Colours::white);
-			}
+			m_TriggerOpenLoggingButton->setColour(TextButton::buttonColourId, Colours::dimgrey);
+			m_TriggerOpenLoggingButton->setColour(Label::textColourId, Colours::white);
 		}
 
-		m_LoggingDialog.reset();
+		// detach the window from the engine before it is destroyed
+		auto loggingDialog = std::move(m_LoggingDialog);
+		UpdateLoggingSinks();
+		loggingDialog.reset();
 	}
 }
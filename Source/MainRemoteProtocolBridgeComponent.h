@@ -38,12 +38,17 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "RemoteProtocolBridgeCommon.h"
 #include "ProcessingEngine/ProcessingEngine.h"
+#include "TrafficLogging/LoggingSinkRegistry.h"
+#include "Configuration/ConfigTree.h"
+#include "EngineControl/EngineController.h"
 
 // Fwd. Declarations
 class MainRemoteProtocolBridgeComponent;
 class GlobalConfigWindow;
 class LoggingWindow;
-class NodeComponent;
+class NodeListComponent;
+class TrafficStatisticsCollector;
+class ConfigUpdateCoalescer;
 
 
 /**
@@ -53,7 +58,8 @@ class NodeComponent;
 class MainRemoteProtocolBridgeComponent   : public Component,
 											public Button::Listener,
 											public ProcessingEngineConfig::Dumper,
-											public ProcessingEngineConfig::Watcher
+											public ProcessingEngineConfig::Watcher,
+											public EngineController::Listener
 {
 public:
     //==============================================================================
@@ -76,9 +82,21 @@ public:
 	//==============================================================================
 	void onConfigUpdated() override;
 
+	//==============================================================================
+	void engineStateChanged(EngineController::EngineState state) override;
+	void engineRequestFinished(EngineController::EngineRequest request, bool succeeded, double durationMs) override;
+
 private:
+	void SetTrafficStatisticsConfig(const XmlElement* trafficLoggingXmlElement);
+	void UpdateLoggingSinks();
+
+	void UpdateConfigSnapshot();
+
+	void StartEngine();
+	void ApplyConfigurationToEngine();
+
     //==============================================================================
-	std::map<NodeId, std::unique_ptr<NodeComponent>>	m_NodeBoxes;				/**< Map holding node components for all active bridging nodes. */
+	std::unique_ptr<NodeListComponent>					m_NodeList;					/**< Scrollable list holding node components for the visible bridging nodes. */
 
 	std::unique_ptr<DrawableButton>						m_AddNodeButton;			/**< Button to add a node. */
 	std::unique_ptr<DrawableButton>						m_RemoveNodeButton;			/**< Button to remove a node. */
@@ -86,13 +104,24 @@ private:
 	std::unique_ptr<TextButton>							m_TriggerOpenConfigButton;	/**< Button to trigger opening configuration. */
 	std::unique_ptr<TextButton>							m_TriggerOpenLoggingButton;	/**< Button to trigger opening logging. */
 	std::unique_ptr<TextButton>							m_EngineStartStopButton;	/**< Button to toggle engine start/stop. */
+	std::unique_ptr<Label>								m_ReconfigurationLabel;		/**< Label to report what the last configuration change affected and the resulting downtime. */
 
 	std::unique_ptr<GlobalConfigWindow>					m_ConfigDialog;				/**< Pointer to configuration dialog instance (created on demand). */
-	std::unique_ptr<XmlElement>							m_GlobalConfigXml;
+	ConfigTree::Ptr										m_GlobalConfig;				/**< Snapshot of the global configuration, shared with the configuration snapshot until edited in the dialog. */
 	std::unique_ptr<LoggingWindow>						m_LoggingDialog;			/**< Pointer to logging dialog instance (created on demand). */
 
 	ProcessingEngine									m_engine;					/**< The processig engine of RemoteProtocolBridge. */
+	std::unique_ptr<EngineController>					m_engineController;			/**< Starts and stops the engine off the message thread. */
+	String												m_pendingReconfigurationText;	/**< Description of the configuration change the engine is being restarted for. */
 	std::unique_ptr<ProcessingEngineConfig>				m_config;					/**< The configuration object for engine. */
+	std::unique_ptr<ConfigUpdateCoalescer>				m_configCoalescer;			/**< Batches the configuration dumps requested by ui edits. */
+	ConfigTree::Ptr										m_configSnapshot;			/**< Shared snapshot of the last known configuration state. */
+	ConfigTree::Ptr										m_runningConfigState;		/**< The configuration state the running engine was started with, to diff changes against. */
+	std::unique_ptr<TrafficStatisticsCollector>			m_statisticsCollector;		/**< Headless statistics exporter, registered as logging sink while exporting. */
+
+	LoggingSinkRegistry									m_loggingSinks;				/**< Registry that is installed as engine logging target and fans out to the logging sinks. */
+	int													m_loggingDialogSinkId;		/**< Sink id of the logging dialog, SRC_InvalidSinkId if not registered. */
+	int													m_statisticsSinkId;			/**< Sink id of the statistics collector, SRC_InvalidSinkId if not registered. */
 
 	void buttonClicked(Button* button) override;
 
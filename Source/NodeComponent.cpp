@@ -37,6 +37,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "MainRemoteProtocolBridgeComponent.h"
 #include "ProtocolComponent.h"
 #include "ConfigComponents/ObjectHandlingConfigComponents/ObjectHandlingConfigComponents.h"
+#include "Configuration/ConfigUpdateCoalescer.h"
 
 #include "ProcessingEngine/ProcessingEngine.h"
 #include "ProcessingEngine/ProcessingEngineConfig.h"
@@ -150,7 +151,7 @@ void NodeComponent::childWindowCloseTriggered(DialogWindow* childWindow)
 	if (m_OHMConfigDialog && childWindow == m_OHMConfigDialog.get())
 	{
 		m_ohmXmlElement = m_OHMConfigDialog->createStateXml();
-		triggerConfigurationUpdate(true);
+		ConfigUpdateCoalescer::CommitUpdate(true);
 
 		if (m_OHMConfigEditButton)
 		{
@@ -212,35 +213,125 @@ std::unique_ptr<XmlElement> NodeComponent::createStateXml()
  */
 bool NodeComponent::setStateXml(XmlElement* stateXml)
 {
-	if (!stateXml || stateXml->getTagName() != ProcessingEngineConfig::getTagName(ProcessingEngineConfig::TagID::NODE))
+	if (!stateXml)
 		return false;
 
-	m_NodeId = static_cast<NodeId>(stateXml->getIntAttribute(ProcessingEngineConfig::getAttributeName(ProcessingEngineConfig::AttributeID::ID)));
+	return SetStateConfig(ConfigTree::FromXml(*stateXml, m_appliedConfig));
+}
 
-	auto objectHandlingStateXml = stateXml->getChildByName(ProcessingEngineConfig::getTagName(ProcessingEngineConfig::TagID::OBJECTHANDLING));
-	if (objectHandlingStateXml)
-		m_ohmXmlElement = std::make_unique<XmlElement>(*objectHandlingStateXml);
-	else
+/**
+ * Method to update ui input elements with data to show from a configuration snapshot.
+ * Only the parts that differ from the last applied snapshot are touched: the object handling
+ * and the protocol groups whose protocols changed. Unchanged subtrees are shared between snapshots,
+ * so for an unchanged node this boils down to an identity check.
+ *
+ * @param stateConfig	The node configuration to show.
+ * @return	True on success, false if the configuration is not a valid node configuration.
+ */
+bool NodeComponent::SetStateConfig(const ConfigTree::Ptr& stateConfig)
+{
+	if (!stateConfig || stateConfig->GetTagName() != ProcessingEngineConfig::getTagName(ProcessingEngineConfig::TagID::NODE))
 		return false;
 
-	ObjectHandlingMode selectedOHM = static_cast<ObjectHandlingMode>(ProcessingEngineConfig::ObjectHandlingModeFromString(m_ohmXmlElement->getStringAttribute(ProcessingEngineConfig::getAttributeName(ProcessingEngineConfig::AttributeID::MODE))));
-	m_NodeModeDrop->setSelectedId(selectedOHM, dontSendNotification);
+	if (stateConfig->IsEquivalentTo(m_appliedConfig.get()))
+		return true;
+
+	// a component that is reused for another node has to show all of its configuration
+	auto nodeId = static_cast<NodeId>(stateConfig->GetIntAttribute(ProcessingEngineConfig::getAttributeName(ProcessingEngineConfig::AttributeID::ID)));
+	if (nodeId != m_NodeId)
+		m_appliedConfig.reset();
+	m_NodeId = nodeId;
 
-	m_protocolsAComponent->setStateXml(stateXml);
-	m_protocolsBComponent->setStateXml(stateXml);
+	auto objectHandlingTagName = ProcessingEngineConfig::getTagName(ProcessingEngineConfig::TagID::OBJECTHANDLING);
+	auto objectHandlingConfig = stateConfig->GetChildByName(objectHandlingTagName);
+	if (!objectHandlingConfig)
+		return false;
+
+	auto previousConfig = std::move(m_appliedConfig);
+	m_appliedConfig = stateConfig;
+
+	if (!previousConfig || !objectHandlingConfig->IsEquivalentTo(previousConfig->GetChildByName(objectHandlingTagName).get()))
+	{
+		m_ohmXmlElement = objectHandlingConfig->CreateXml();
+
+		ObjectHandlingMode selectedOHM = static_cast<ObjectHandlingMode>(ProcessingEngineConfig::ObjectHandlingModeFromString(m_ohmXmlElement->getStringAttribute(ProcessingEngineConfig::getAttributeName(ProcessingEngineConfig::AttributeID::MODE))));
+		m_NodeModeDrop->setSelectedId(selectedOHM, dontSendNotification);
+	}
+
+	// the protocol groups take the node element, it is created once if any of them needs it
+	std::unique_ptr<XmlElement> stateXml;
+	if (HaveProtocolsChanged(previousConfig.get(), stateConfig.get(), ProcessingEngineConfig::getTagName(ProcessingEngineConfig::TagID::PROTOCOLA)))
+	{
+		stateXml = stateConfig->CreateXml();
+		m_protocolsAComponent->setStateXml(stateXml.get());
+	}
+	if (HaveProtocolsChanged(previousConfig.get(), stateConfig.get(), ProcessingEngineConfig::getTagName(ProcessingEngineConfig::TagID::PROTOCOLB)))
+	{
+		if (!stateXml)
+			stateXml = stateConfig->CreateXml();
+		m_protocolsBComponent->setStateXml(stateXml.get());
+	}
 
 	return true;
 }
 
+/**
+ * Helper method to compare the protocols of one role between two node configurations, in order.
+ *
+ * @param previousConfig	The previously applied node configuration. May be nullptr.
+ * @param currentConfig		The new node configuration.
+ * @param protocolTagName	The tag of the protocol role to compare.
+ * @return	True if protocols of the role were added, removed or changed.
+ */
+bool NodeComponent::HaveProtocolsChanged(const ConfigTree* previousConfig, const ConfigTree* currentConfig, const String& protocolTagName)
+{
+	if (!previousConfig)
+		return true;
+
+	auto previousIndex = 0;
+	auto currentIndex = 0;
+	while (true)
+	{
+		while (previousIndex < previousConfig->GetNumChildren() && previousConfig->GetChild(previousIndex)->GetTagName() != protocolTagName)
+			previousIndex++;
+		while (currentIndex < currentConfig->GetNumChildren() && currentConfig->GetChild(currentIndex)->GetTagName() != protocolTagName)
+			currentIndex++;
+
+		auto previousDone = previousIndex >= previousConfig->GetNumChildren();
+		auto currentDone = currentIndex >= currentConfig->GetNumChildren();
+		if (previousDone || currentDone)
+			return previousDone != currentDone;
+
+		if (!previousConfig->GetChild(previousIndex)->IsEquivalentTo(currentConfig->GetChild(currentIndex).get()))
+			return true;
+
+		previousIndex++;
+		currentIndex++;
+	}
+}
+
 /**
  *
  */
 int NodeComponent::GetCurrentRequiredHeight()
+{
+	return GetRequiredHeight(m_protocolsAComponent->GetProtocolIds().size(), m_protocolsBComponent->GetProtocolIds().size());
+}
+
+/**
+ * Helper method to calculate the height a node requires for given numbers of protocols,
+ * without the need for an existing component.
+ *
+ * @param protocolACount	The number of role A protocols.
+ * @param protocolBCount	The number of role B protocols.
+ * @return	The required height.
+ */
+int NodeComponent::GetRequiredHeight(int protocolACount, int protocolBCount)
 {
 	int requiredHeight = 0;
     
-	requiredHeight += m_protocolsAComponent->GetCurrentRequiredHeight();
-	requiredHeight += m_protocolsBComponent->GetCurrentRequiredHeight();
+	requiredHeight += ProtocolGroupComponent::GetRequiredHeight(protocolACount);
+	requiredHeight += ProtocolGroupComponent::GetRequiredHeight(protocolBCount);
 	requiredHeight += UIS_Margin_s;
 
 	requiredHeight += UIS_ElmSize + UIS_Margin_m;
@@ -258,6 +349,26 @@ NodeId NodeComponent::GetNodeId()
 	return m_NodeId;
 }
 
+/**
+ * Getter for an open object handling or protocol configuration dialog of this node.
+ *
+ * @return	True if a configuration dialog is open.
+ */
+bool NodeComponent::HasOpenConfigDialog()
+{
+	return m_OHMConfigDialog != nullptr || m_protocolsAComponent->HasOpenConfigDialog() || m_protocolsBComponent->HasOpenConfigDialog();
+}
+
+/**
+ * Method to show if the node is bridging, by highlighting the outline of the node component.
+ *
+ * @param running	True if the engine is running with this node.
+ */
+void NodeComponent::SetRunning(bool running)
+{
+	GroupComponent::setColour(outlineColourId, running ? Colours::lightgreen : Colours::white);
+}
+
 /**
  * Method to add the parent listener to this instance of NodeComponent.
  * This can afterwards be used for e.g. callbacks, etc.
@@ -283,7 +394,7 @@ void NodeComponent::buttonClicked(Button* button)
 		ToggleOpenCloseObjectHandlingConfig(m_OHMConfigEditButton.get());
 	}
 	else
-		triggerConfigurationUpdate(true);
+		ConfigUpdateCoalescer::CommitUpdate(true);
 }
 
 /**
@@ -296,12 +407,13 @@ void NodeComponent::comboBoxChanged(ComboBox* comboBox)
 {
 	ignoreUnused(comboBox);
 
-	triggerConfigurationUpdate(true);
+	ConfigUpdateCoalescer::CommitUpdate(true);
 }
 
 /**
  * Overloaded method called by TextEditor objects on textchange events.
- * This is similar to ::buttonClicked but originates from inherited TextEditor::Listener
+ * This is similar to ::buttonClicked but originates from inherited TextEditor::Listener.
+ * Keystrokes are coalesced, the configuration is dumped once typing paused.
  *
  * @param textEdit	The textEdit object that has been changed
  */
@@ -309,7 +421,7 @@ void NodeComponent::textEditorTextChanged(TextEditor& textEdit)
 {
 	ignoreUnused(textEdit);
 
-	triggerConfigurationUpdate(true);
+	ConfigUpdateCoalescer::ScheduleUpdate(true);
 }
 
 /**
@@ -322,7 +434,7 @@ void NodeComponent::textEditorReturnKeyPressed(TextEditor& textEdit)
 {
 	ignoreUnused(textEdit);
 
-	triggerConfigurationUpdate(true);
+	ConfigUpdateCoalescer::CommitUpdate(true);
 }
 
 /**
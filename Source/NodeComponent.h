@@ -38,6 +38,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "RemoteProtocolBridgeCommon.h"
 #include "ConfigComponents/ObjectHandlingConfigComponents/ObjectHandlingConfigComponents.h"
+#include "Configuration/ConfigTree.h"
 
 // Fwd. Declarations
 class MainRemoteProtocolBridgeComponent;
@@ -77,6 +78,9 @@ public:
 	//==============================================================================
 	NodeId GetNodeId();
 	int GetCurrentRequiredHeight();
+	static int GetRequiredHeight(int protocolACount, int protocolBCount);
+	bool HasOpenConfigDialog();
+	void SetRunning(bool running);
     
     //==============================================================================
     void AddListener(MainRemoteProtocolBridgeComponent* listener);
@@ -84,8 +88,11 @@ public:
 	//==============================================================================
 	std::unique_ptr<XmlElement> createStateXml() override;
 	bool setStateXml(XmlElement* stateXml) override;
+	bool SetStateConfig(const ConfigTree::Ptr& stateConfig);
 
 private:
+	static bool HaveProtocolsChanged(const ConfigTree* previousConfig, const ConfigTree* currentConfig, const String& protocolTagName);
+
     NodeId											m_NodeId;				/**< Id of the node this component manages configuration for. */
     																		
 	MainRemoteProtocolBridgeComponent*				m_parentComponent;		/**< The parent component that needs to be triggered regarding callbacks. */
@@ -100,6 +107,7 @@ private:
 	std::unique_ptr<ObjectHandlingConfigWindow>		m_OHMConfigDialog;		/**< Member to hold instance of object handling mode config dialog that is created on demand. */
 
 	std::unique_ptr<XmlElement>						m_ohmXmlElement;
+	ConfigTree::Ptr									m_appliedConfig;		/**< The node configuration last shown on the ui, to only update the parts that changed. */
 
 	void buttonClicked(Button* button) override;
 	void comboBoxChanged(ComboBox* comboBox) override;
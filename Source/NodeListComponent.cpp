@@ -0,0 +1,306 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#include "NodeListComponent.h"
+
+#include "NodeComponent.h"
+#include "Configuration/ConfigUpdateCoalescer.h"
+
+#include "ProcessingEngine/ProcessingEngineConfig.h"
+
+
+// **************************************************************************************
+//    class NodeListComponent
+// **************************************************************************************
+/**
+ * Constructor
+ *
+ * @param parentComponent	The parent component the node components send their callbacks to.
+ */
+NodeListComponent::NodeListComponent(MainRemoteProtocolBridgeComponent* parentComponent)
+	: Viewport(),
+	m_parentComponent(parentComponent)
+{
+	m_listContent = std::make_unique<Component>();
+	setViewedComponent(m_listContent.get(), false);
+	setScrollBarsShown(true, false);
+}
+
+/**
+ * Destructor
+ */
+NodeListComponent::~NodeListComponent()
+{
+	m_nodeComponents.clear();
+	m_unusedNodeComponents.clear();
+
+	setViewedComponent(nullptr, false);
+}
+
+/**
+ * Method to set the configurations of the nodes to list. Components of removed nodes are dropped,
+ * components of listed nodes are updated (which only touches what changed) and the list is laid out again.
+ *
+ * @param nodeConfigs	The configurations of all nodes, in list order.
+ */
+void NodeListComponent::SetNodeConfigs(const std::vector<ConfigTree::Ptr>& nodeConfigs)
+{
+	auto idAttributeName = ProcessingEngineConfig::getAttributeName(ProcessingEngineConfig::AttributeID::ID);
+	auto protocolATagName = ProcessingEngineConfig::getTagName(ProcessingEngineConfig::TagID::PROTOCOLA);
+	auto protocolBTagName = ProcessingEngineConfig::getTagName(ProcessingEngineConfig::TagID::PROTOCOLB);
+
+	m_nodeConfigs = nodeConfigs;
+	m_nodeIds.clear();
+	m_nodeIndices.clear();
+	m_nodeRequiredHeights.clear();
+	for (auto const& nodeConfig : m_nodeConfigs)
+	{
+		auto protocolACount = 0;
+		auto protocolBCount = 0;
+		for (auto i = 0; i < nodeConfig->GetNumChildren(); ++i)
+		{
+			auto const& tagName = nodeConfig->GetChild(i)->GetTagName();
+			if (tagName == protocolATagName)
+				protocolACount++;
+			else if (tagName == protocolBTagName)
+				protocolBCount++;
+		}
+
+		auto nodeId = static_cast<NodeId>(nodeConfig->GetIntAttribute(idAttributeName));
+		m_nodeIndices[nodeId] = static_cast<int>(m_nodeIds.size());
+		m_nodeIds.push_back(nodeId);
+		m_nodeRequiredHeights.push_back(NodeComponent::GetRequiredHeight(protocolACount, protocolBCount));
+	}
+
+	for (auto iter = m_nodeComponents.begin(); iter != m_nodeComponents.end();)
+	{
+		if (m_nodeIndices.count(iter->first) == 0)
+		{
+			RecycleNodeComponent(std::move(iter->second));
+			iter = m_nodeComponents.erase(iter);
+		}
+		else
+		{
+			iter->second->SetStateConfig(m_nodeConfigs[size_t(m_nodeIndices.at(iter->first))]);
+			++iter;
+		}
+	}
+
+	UpdateLayout();
+}
+
+/**
+ * Getter for the number of listed nodes.
+ *
+ * @return	The number of nodes, including those without a component.
+ */
+int NodeListComponent::GetNodeCount() const
+{
+	return static_cast<int>(m_nodeConfigs.size());
+}
+
+/**
+ * Getter for the height all listed nodes require together.
+ *
+ * @return	The required height.
+ */
+int NodeListComponent::GetRequiredHeight() const
+{
+	auto requiredHeight = 0;
+	for (auto nodeRequiredHeight : m_nodeRequiredHeights)
+		requiredHeight += nodeRequiredHeight;
+
+	return requiredHeight;
+}
+
+/**
+ * Getter for the node components currently in use. Nodes without a component show what is in the
+ * configuration, so these are the only ones whose ui state has to be dumped.
+ *
+ * @return	The node components.
+ */
+Array<NodeComponent*> NodeListComponent::GetNodeComponents() const
+{
+	Array<NodeComponent*> nodeComponents;
+	for (auto const& nodeComponentKV : m_nodeComponents)
+		nodeComponents.add(nodeComponentKV.second.get());
+
+	return nodeComponents;
+}
+
+/**
+ * Method to set the nodes the engine is running with, to be shown on their node components.
+ *
+ * @param runningNodeIds	The ids of the running nodes, empty if the engine is not running.
+ */
+void NodeListComponent::SetRunningNodeIds(const Array<NodeId>& runningNodeIds)
+{
+	m_runningNodeIds = runningNodeIds;
+
+	for (auto const& nodeComponentKV : m_nodeComponents)
+		nodeComponentKV.second->SetRunning(m_runningNodeIds.contains(nodeComponentKV.first));
+}
+
+/**
+ * Overloaded method to resize contents
+ */
+void NodeListComponent::resized()
+{
+	Viewport::resized();
+
+	UpdateLayout();
+}
+
+/**
+ * Reimplemented from Viewport to update the node components when the list was scrolled.
+ *
+ * @param newVisibleArea	The now visible area of the list content.
+ */
+void NodeListComponent::visibleAreaChanged(const Rectangle<int>& newVisibleArea)
+{
+	ignoreUnused(newVisibleArea);
+
+	UpdateVisibleNodes();
+}
+
+/**
+ * Helper method to calculate the node positions and size the list content accordingly.
+ * As long as all nodes fit into the visible area, they share the remaining height evenly.
+ */
+void NodeListComponent::UpdateLayout()
+{
+	auto nodeCount = static_cast<int>(m_nodeConfigs.size());
+	auto requiredHeight = GetRequiredHeight();
+	auto availableHeight = getMaximumVisibleHeight() - UIS_Margin_s;
+	auto scrolling = requiredHeight > availableHeight;
+	auto extraHeight = (nodeCount > 0 && !scrolling) ? (availableHeight - requiredHeight) / nodeCount : 0;
+
+	m_nodePositions.resize(size_t(nodeCount + 1));
+	m_nodePositions[0] = UIS_Margin_s;
+	for (auto i = size_t(0); i < size_t(nodeCount); ++i)
+		m_nodePositions[i + 1] = m_nodePositions[i] + m_nodeRequiredHeights[i] + extraHeight;
+
+	m_listContent->setSize(getMaximumVisibleWidth() - (scrolling ? getScrollBarThickness() : 0), m_nodePositions.back());
+
+	UpdateVisibleNodes();
+}
+
+/**
+ * Helper method to hand out node components to the nodes in and near the visible area and to place them.
+ * Components of other nodes are recycled, unless they may hold edits that are not in the configuration yet.
+ */
+void NodeListComponent::UpdateVisibleNodes()
+{
+	if (m_nodePositions.empty())
+		return;
+
+	// the node positions are ascending, so the range of nodes to show is found by bisection
+	auto viewArea = getViewArea().expanded(0, NLC_OverscanHeight);
+	auto firstNodeIndex = static_cast<int>(std::upper_bound(m_nodePositions.begin() + 1, m_nodePositions.end(), viewArea.getY()) - (m_nodePositions.begin() + 1));
+	auto endNodeIndex = static_cast<int>(std::lower_bound(m_nodePositions.begin(), m_nodePositions.end() - 1, viewArea.getBottom()) - m_nodePositions.begin());
+
+	// while a dump is pending, the components are the only place the edits are in
+	auto coalescer = ConfigUpdateCoalescer::getInstance();
+	auto dumpPending = coalescer && coalescer->IsDumpPending();
+
+	for (auto iter = m_nodeComponents.begin(); iter != m_nodeComponents.end();)
+	{
+		auto nodeIndex = m_nodeIndices.at(iter->first);
+		if ((nodeIndex < firstNodeIndex || nodeIndex >= endNodeIndex) && !dumpPending && IsRecyclable(*iter->second))
+		{
+			RecycleNodeComponent(std::move(iter->second));
+			iter = m_nodeComponents.erase(iter);
+		}
+		else
+			++iter;
+	}
+
+	for (auto i = firstNodeIndex; i < endNodeIndex; ++i)
+	{
+		auto nodeId = m_nodeIds[size_t(i)];
+		if (m_nodeComponents.count(nodeId) > 0)
+			continue;
+
+		std::unique_ptr<NodeComponent> nodeComponent;
+		if (!m_unusedNodeComponents.empty())
+		{
+			nodeComponent = std::move(m_unusedNodeComponents.back());
+			m_unusedNodeComponents.pop_back();
+		}
+		else
+		{
+			nodeComponent = std::make_unique<NodeComponent>(nodeId);
+			nodeComponent->AddListener(m_parentComponent);
+		}
+
+		nodeComponent->setText("Protocol Bridging Node Id" + String(nodeId));
+		nodeComponent->SetStateConfig(m_nodeConfigs[size_t(i)]);
+		nodeComponent->SetRunning(m_runningNodeIds.contains(nodeId));
+		m_listContent->addAndMakeVisible(nodeComponent.get());
+
+		m_nodeComponents[nodeId] = std::move(nodeComponent);
+	}
+
+	auto nodeWidth = m_listContent->getWidth() - 2 * UIS_Margin_s;
+	for (auto const& nodeComponentKV : m_nodeComponents)
+	{
+		auto nodeIndex = size_t(m_nodeIndices.at(nodeComponentKV.first));
+		nodeComponentKV.second->setBounds(UIS_Margin_s, m_nodePositions[nodeIndex], nodeWidth, m_nodePositions[nodeIndex + 1] - m_nodePositions[nodeIndex]);
+	}
+}
+
+/**
+ * Helper method to check if a node component can be handed to another node.
+ *
+ * @param nodeComponent	The node component to check.
+ * @return	False if the user is typing in it or has one of its configuration dialogs open.
+ */
+bool NodeListComponent::IsRecyclable(NodeComponent& nodeComponent) const
+{
+	return !nodeComponent.hasKeyboardFocus(true) && !nodeComponent.HasOpenConfigDialog();
+}
+
+/**
+ * Helper method to take a node component out of use. It is kept for recycling, or destroyed
+ * if enough components are kept already or it still has a configuration dialog open.
+ *
+ * @param nodeComponent	The node component that is no longer used.
+ */
+void NodeListComponent::RecycleNodeComponent(std::unique_ptr<NodeComponent> nodeComponent)
+{
+	m_listContent->removeChildComponent(nodeComponent.get());
+
+	if (m_unusedNodeComponents.size() < size_t(NLC_MaxUnusedNodeComponents) && !nodeComponent->HasOpenConfigDialog())
+		m_unusedNodeComponents.push_back(std::move(nodeComponent));
+}
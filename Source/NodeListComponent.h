@@ -0,0 +1,100 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "RemoteProtocolBridgeCommon.h"
+#include "Configuration/ConfigTree.h"
+
+// Fwd. Declarations
+class MainRemoteProtocolBridgeComponent;
+class NodeComponent;
+
+
+/**
+ * Class NodeListComponent is a scrollable list of all bridging nodes that only holds node components
+ * for the nodes in and near the visible area. The list is laid out from the node configurations alone,
+ * components of nodes that are scrolled out of view are recycled for the nodes that come into view.
+ * That keeps memory and layout time flat with the number of nodes.
+ */
+class NodeListComponent : public Viewport
+{
+public:
+	enum NodeListConstants
+	{
+		NLC_OverscanHeight = 200,			/**< Height above and below the visible area whose nodes get components as well, so scrolling does not create components on every step. */
+		NLC_MaxUnusedNodeComponents = 4,	/**< Number of node components that are kept for recycling when not in use. */
+		NLC_MaxAutoSizeHeight = 720,		/**< Node area height up to which the main window grows with the nodes, larger lists are scrolled. */
+	};
+
+public:
+	NodeListComponent(MainRemoteProtocolBridgeComponent* parentComponent);
+	~NodeListComponent();
+
+	//==============================================================================
+	void SetNodeConfigs(const std::vector<ConfigTree::Ptr>& nodeConfigs);
+	int GetNodeCount() const;
+	int GetRequiredHeight() const;
+	Array<NodeComponent*> GetNodeComponents() const;
+	void SetRunningNodeIds(const Array<NodeId>& runningNodeIds);
+
+	//==============================================================================
+	void resized() override;
+	void visibleAreaChanged(const Rectangle<int>& newVisibleArea) override;
+
+private:
+	void UpdateLayout();
+	void UpdateVisibleNodes();
+	bool IsRecyclable(NodeComponent& nodeComponent) const;
+	void RecycleNodeComponent(std::unique_ptr<NodeComponent> nodeComponent);
+
+private:
+	MainRemoteProtocolBridgeComponent*					m_parentComponent;		/**< The parent component node components send their callbacks to. */
+	std::unique_ptr<Component>							m_listContent;			/**< The scrolled component the node components are placed on. */
+
+	std::vector<ConfigTree::Ptr>						m_nodeConfigs;			/**< The configurations of all nodes, in list order. */
+	std::vector<NodeId>									m_nodeIds;				/**< The ids of all nodes, in list order. */
+	std::map<NodeId, int>								m_nodeIndices;			/**< The list position per node id. */
+	std::vector<int>									m_nodeRequiredHeights;	/**< The height every node requires, calculated from its configuration. */
+	std::vector<int>									m_nodePositions;		/**< The top position of every node on the list content, followed by the bottom of the last one. */
+
+	std::map<NodeId, std::unique_ptr<NodeComponent>>	m_nodeComponents;		/**< The node components currently in use, by node id. */
+	std::vector<std::unique_ptr<NodeComponent>>			m_unusedNodeComponents;	/**< Node components kept for recycling. */
+
+	Array<NodeId>										m_runningNodeIds;		/**< The ids of the nodes the engine is running with. */
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(NodeListComponent)
+};
@@ -37,6 +37,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "NodeComponent.h"
 #include "ConfigComponents/ProtocolConfigComponents/ProtocolConfigComponents.h"
 #include "ProcessingEngine/ProcessingEngineConfig.h"
+#include "Configuration/ConfigUpdateCoalescer.h"
 
 #include <Image_utils.h>
 
@@ -152,7 +153,16 @@ bool ProtocolGroupComponent::setStateXml(XmlElement* stateXml)
 	if (!stateXml || stateXml->getTagName() != ProcessingEngineConfig::getTagName(ProcessingEngineConfig::TagID::NODE))
 		return false;
 
-	m_NodeId = stateXml->getIntAttribute(ProcessingEngineConfig::getAttributeName(ProcessingEngineConfig::AttributeID::ID));
+	auto nodeId = static_cast<NodeId>(stateXml->getIntAttribute(ProcessingEngineConfig::getAttributeName(ProcessingEngineConfig::AttributeID::ID)));
+	if (nodeId != m_NodeId)
+	{
+		// the group is reused for another node, none of the protocol components belongs to it
+		for (auto const& protocolComponentKV : m_ProtocolComponents)
+			removeChildComponent(protocolComponentKV.second.get());
+		m_ProtocolComponents.clear();
+		m_ProtocolIds.clear();
+	}
+	m_NodeId = nodeId;
 
 	auto protocolRoles = std::map<ProtocolId, ProtocolRole>{};
 	auto protocolXmls = std::map<ProtocolId, XmlElement*>{};
@@ -202,12 +212,23 @@ bool ProtocolGroupComponent::setStateXml(XmlElement* stateXml)
 }
 
 int ProtocolGroupComponent::GetCurrentRequiredHeight()
+{
+	return GetRequiredHeight(static_cast<int>(m_ProtocolComponents.size()));
+}
+
+/**
+ * Helper method to calculate the height a group requires for a given number of protocols,
+ * without the need for an existing component.
+ *
+ * @param protocolCount	The number of protocols in the group.
+ * @return	The required height.
+ */
+int ProtocolGroupComponent::GetRequiredHeight(int protocolCount)
 {
 	// top margin v space
 	int requiredHeight = UIS_Margin_m;
 
-	for(auto const & protocolComponent : m_ProtocolComponents)
-		requiredHeight += protocolComponent.second->GetCurrentRequiredHeight();
+	requiredHeight += protocolCount * UIS_ElmSize;
 	
 	// margin v space
 	requiredHeight += UIS_Margin_s;
@@ -250,10 +271,24 @@ void ProtocolGroupComponent::RemoveProtocol(const ProtocolId& PId)
 	{
 		m_ProtocolComponents.erase(PId);
 		m_ProtocolIds.remove(m_ProtocolIds.indexOf(PId));
-		triggerConfigurationUpdate(true);
+		ConfigUpdateCoalescer::CommitUpdate(true);
 	}
 }
 
+/**
+ * Getter for an open extended configuration dialog of any protocol in this group.
+ *
+ * @return	True if a protocol configuration dialog is open.
+ */
+bool ProtocolGroupComponent::HasOpenConfigDialog()
+{
+	for (auto const& protocolComponentKV : m_ProtocolComponents)
+		if (protocolComponentKV.second && protocolComponentKV.second->HasOpenConfigDialog())
+			return true;
+
+	return false;
+}
+
 /**
  * Overloaded method called by button objects on click events.
  * All internal button objects are registered to trigger this by calling
@@ -265,21 +300,13 @@ void ProtocolGroupComponent::buttonClicked(Button* button)
 {
 	if (button == m_AddProtocolButton.get())
 	{
-
-		auto config = ProcessingEngineConfig::getInstance();
-		if (config)
+		// the own protocols are all that is needed, no need to copy the complete configuration state
+		auto nodeXmlElement = createStateXml();
+		if (nodeXmlElement)
 		{
-			auto currentState = config->getConfigState();
-			if (currentState)
-			{
-				auto nodeXmlElement = currentState->getChildByAttribute(ProcessingEngineConfig::getAttributeName(ProcessingEngineConfig::AttributeID::ID), String(m_NodeId));
-				if (nodeXmlElement)
-				{
-					nodeXmlElement->addChildElement(ProcessingEngineConfig::GetDefaultProtocol(m_ProtocolRole).release());
-					setStateXml(nodeXmlElement);
-					triggerConfigurationUpdate(true);
-				}
-			}
+			nodeXmlElement->addChildElement(ProcessingEngineConfig::GetDefaultProtocol(m_ProtocolRole).release());
+			setStateXml(nodeXmlElement.get());
+			ConfigUpdateCoalescer::CommitUpdate(true);
 		}
 	}
 	else if (button == m_RemoveProtocolButton.get())
@@ -529,6 +556,16 @@ ProtocolId ProtocolComponent::GetProtocolId()
 	return m_ProtocolId;
 }
 
+/**
+ * Getter for the extended protocol configuration dialog being open.
+ *
+ * @return	True if the dialog is open.
+ */
+bool ProtocolComponent::HasOpenConfigDialog()
+{
+	return m_ProtocolConfigDialog != nullptr;
+}
+
 /**
  * Overloaded method called by button objects on click events.
  * All internal button objects are registered to trigger this by calling
@@ -546,21 +583,22 @@ void ProtocolComponent::buttonClicked(Button* button)
 
 /**
  * Overloaded method called by ComboBox objects on change events.
- * This is similar to ::buttonClicked but originates from inherited ComboBox::Listener
+ * This is similar to ::buttonClicked but originates from inherited ComboBox::Listener.
+ * Changing the protocol type also updates dependent fields, all of it is dumped as one change.
  *
  * @param comboBox	The comboBox object that has been changed
  */
 void ProtocolComponent::comboBoxChanged(ComboBox* comboBox)
 {
+	ConfigUpdateCoalescer::ScopedTransaction transaction;
+
 	if (comboBox == m_ProtocolDrop.get())
 	{
 		auto protocolType = static_cast<ProtocolType>(m_ProtocolDrop->getSelectedId());
 		setZeroConfProtocolType(protocolType);
 	}
 
-	auto config = ProcessingEngineConfig::getInstance();
-	if (config)
-		config->triggerConfigurationDump();
+	ConfigUpdateCoalescer::CommitUpdate();
 }
 
 /**
@@ -584,9 +622,7 @@ void ProtocolComponent::textEditorReturnKeyPressed(TextEditor& textEdit)
 {
 	ignoreUnused(textEdit);
 
-	auto config = ProcessingEngineConfig::getInstance();
-	if (config)
-		config->triggerConfigurationDump();
+	ConfigUpdateCoalescer::CommitUpdate();
 }
 
 /**
@@ -609,6 +645,9 @@ void ProtocolComponent::textEditorEscapeKeyPressed(TextEditor& textEdit)
 void ProtocolComponent::textEditorFocusLost(TextEditor& textEdit)
 {
 	ignoreUnused(textEdit);
+
+	// a half typed address is only taken into the configuration once editing is finished
+	ConfigUpdateCoalescer::CommitUpdate();
 }
 
 /**
@@ -629,7 +668,7 @@ void ProtocolComponent::ToggleOpenCloseProtocolConfig(Button* button)
 		if (m_protocolXmlElement)
 		{
 			m_protocolXmlElement = m_ProtocolConfigDialog->createStateXml();
-			triggerConfigurationUpdate(true);
+			ConfigUpdateCoalescer::CommitUpdate(true);
 		}
 
 		button->setColour(TextButton::buttonColourId, Colours::dimgrey);
@@ -72,7 +72,9 @@ public:
 	NodeId GetNodeId();
 	const Array<ProtocolId>& GetProtocolIds();
 	int GetCurrentRequiredHeight();
+	static int GetRequiredHeight(int protocolCount);
 	void RemoveProtocol(const ProtocolId& PId);
+	bool HasOpenConfigDialog();
 
 private:
     //==============================================================================
@@ -118,6 +120,7 @@ public:
 	void ToggleOpenCloseProtocolConfig(Button* button);
 	ProtocolId GetProtocolId();
 	int GetCurrentRequiredHeight();
+	bool HasOpenConfigDialog();
 
 	//==============================================================================
 	std::unique_ptr<XmlElement> createStateXml() override;
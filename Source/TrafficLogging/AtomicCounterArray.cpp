@@ -0,0 +1,90 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#include "AtomicCounterArray.h"
+
+
+// **************************************************************************************
+//    class AtomicCounterArray
+// **************************************************************************************
+/**
+ * Constructor. All counters are allocated and zeroed here.
+ *
+ * @param size	The number of ids (0..size-1) that are counted individually.
+ */
+AtomicCounterArray::AtomicCounterArray(int size)
+	: m_size(jmax(1, size))
+{
+	m_counters = std::make_unique<PaddedCounter[]>(static_cast<size_t>(m_size) + 1);
+}
+
+/**
+ * Destructor
+ */
+AtomicCounterArray::~AtomicCounterArray()
+{
+}
+
+/**
+ * Getter for the number of individually counted ids.
+ *
+ * @return	The array size.
+ */
+int AtomicCounterArray::GetSize() const
+{
+	return m_size;
+}
+
+/**
+ * Method to read and reset the counter of an id in one atomic step, so no
+ * increase that happens concurrently is lost. Only one thread must take counts.
+ *
+ * @param id	The id to take the count of. Must be in range 0..GetSize()-1.
+ * @return	The count since the last call.
+ */
+uint32 AtomicCounterArray::TakeCount(int id)
+{
+	jassert(id >= 0 && id < m_size);
+	return m_counters[static_cast<size_t>(id)]._count.exchange(0, std::memory_order_relaxed);
+}
+
+/**
+ * Method to read and reset the counter of all ids outside of the array range.
+ *
+ * @return	The overflow count since the last call.
+ */
+uint32 AtomicCounterArray::TakeOverflowCount()
+{
+	return m_counters[static_cast<size_t>(m_size)]._count.exchange(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,80 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+
+/**
+ * Class AtomicCounterArray is a fixed size array of counters that may be increased from any number
+ * of threads without locking, and that is periodically snapshotted and reset by a single reader.
+ * Every counter lives on its own cache line, so threads counting for different ids do not contend.
+ */
+class AtomicCounterArray
+{
+public:
+	AtomicCounterArray(int size);
+	~AtomicCounterArray();
+
+	//==============================================================================
+	/**
+	 * Method to increase the counter of an id. This may be called from any thread concurrently.
+	 * Ids outside of the array range are summed up in an extra overflow counter.
+	 *
+	 * @param id		The id to count for.
+	 * @param amount	The amount to add to the counter.
+	 */
+	void Increase(int id, uint32 amount = 1)
+	{
+		auto index = (id >= 0 && id < m_size) ? id : m_size;
+		m_counters[static_cast<size_t>(index)]._count.fetch_add(amount, std::memory_order_relaxed);
+	};
+
+	//==============================================================================
+	int GetSize() const;
+	uint32 TakeCount(int id);
+	uint32 TakeOverflowCount();
+
+private:
+	struct alignas(64) PaddedCounter
+	{
+		std::atomic<uint32>	_count{ 0 };	/**< The counter value. */
+	};
+
+	std::unique_ptr<PaddedCounter[]>	m_counters;	/**< The counters, with one extra overflow counter at the end. */
+	int									m_size;		/**< Number of counters, without the overflow counter. */
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AtomicCounterArray)
+};
@@ -0,0 +1,324 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#include "LogLineFormatter.h"
+
+#include "ProcessingEngine/ProcessingEngineConfig.h"
+#include "ProcessingEngine/ProtocolProcessor/OSCProtocolProcessor/OSCProtocolProcessor.h"
+#include "ProcessingEngine/ProtocolProcessor/OCAProtocolProcessor/OCAProtocolProcessor.h"
+
+#include <charconv>
+#include <cstdio>
+
+
+/**
+ * Struct LogLineNameTables holds the UTF-8 names of all protocol types and remote objects.
+ * The names are looked up once from the protocol processors and the engine config,
+ * so formatting a line does not create temporary Strings for them.
+ */
+struct LogLineNameTables
+{
+	enum NameTableConstants
+	{
+		NTC_ProtocolTypeCount	= PT_UserMAX + 1,
+		NTC_ObjectCount			= ROI_BridgingMAX + 1,
+	};
+
+	LogLineNameTables()
+	{
+		for (int i = 0; i < NTC_ProtocolTypeCount; ++i)
+			_protocolTypeNames[i] = ProcessingEngineConfig::ProtocolTypeToString(static_cast<ProtocolType>(i)).toStdString();
+
+		for (int i = 0; i < NTC_ObjectCount; ++i)
+		{
+			auto Id = static_cast<RemoteObjectIdentifier>(i);
+			_oscObjectNames[i] = OSCProtocolProcessor::GetRemoteObjectString(Id).toStdString();
+			_ocaObjectNames[i] = OCAProtocolProcessor::GetRemoteObjectString(Id).toStdString();
+			_shortObjectNames[i] = ProcessingEngineConfig::GetObjectShortDescription(Id).toStdString();
+		}
+	};
+
+	std::string	_protocolTypeNames[NTC_ProtocolTypeCount];	/**< Names of the protocol types. */
+	std::string	_oscObjectNames[NTC_ObjectCount];			/**< Object names as used by OSC protocols. */
+	std::string	_ocaObjectNames[NTC_ObjectCount];			/**< Object names as used by OCA protocols. */
+	std::string	_shortObjectNames[NTC_ObjectCount];			/**< Short object descriptions, used by all other protocols. */
+};
+
+/**
+ * Helper to access the name tables. They are created thread-safe on first access.
+ *
+ * @return	The name tables.
+ */
+static const LogLineNameTables& GetNameTables()
+{
+	static const LogLineNameTables nameTables;
+	return nameTables;
+}
+
+
+// **************************************************************************************
+//    class LogLineFormatter
+// **************************************************************************************
+/**
+ * Constructor
+ */
+LogLineFormatter::LogLineFormatter()
+{
+	Clear();
+}
+
+/**
+ * Destructor
+ */
+LogLineFormatter::~LogLineFormatter()
+{
+}
+
+/**
+ * Getter for the formatter that is reused by all callers on the current thread.
+ *
+ * @return	The formatter of the calling thread.
+ */
+LogLineFormatter& LogLineFormatter::GetThreadInstance()
+{
+	thread_local LogLineFormatter formatter;
+	return formatter;
+}
+
+/**
+ * Getter for the interned name of a protocol type.
+ *
+ * @param type	The protocol type.
+ * @return	The name, an empty string for unknown types.
+ */
+const char* LogLineFormatter::GetProtocolTypeName(ProtocolType type)
+{
+	auto index = static_cast<int>(type);
+	if (index < 0 || index >= LogLineNameTables::NTC_ProtocolTypeCount)
+		return "";
+
+	return GetNameTables()._protocolTypeNames[index].c_str();
+}
+
+/**
+ * Getter for the interned name of a remote object, in the notation of the given protocol type.
+ *
+ * @param type	The protocol type the object name is used for.
+ * @param Id	The remote object.
+ * @return	The name, an empty string for unknown objects.
+ */
+const char* LogLineFormatter::GetObjectName(ProtocolType type, RemoteObjectIdentifier Id)
+{
+	auto index = static_cast<int>(Id);
+	if (index < 0 || index >= LogLineNameTables::NTC_ObjectCount)
+		return "";
+
+	auto const& nameTables = GetNameTables();
+	switch (type)
+	{
+	case PT_OSCProtocol:
+		return nameTables._oscObjectNames[index].c_str();
+	case PT_OCAProtocol:
+		return nameTables._ocaObjectNames[index].c_str();
+	default:
+		return nameTables._shortObjectNames[index].c_str();
+	}
+}
+
+/**
+ * Method to format the complete log line of a record,
+ * e.g. "Node1[In:OSC:PId2]: /dbaudio1/coordinatemapping/source_position_xy | ch1 rec1 | 0.500000 0.250000".
+ *
+ * @param record	The record to format.
+ * @return	The zero terminated line, valid until the next call on this formatter.
+ */
+const char* LogLineFormatter::FormatLine(const LogRecord& record)
+{
+	Clear();
+
+	Append("Node");
+	AppendInt(static_cast<int>(record._nodeId));
+	Append("[In:");
+	Append(GetProtocolTypeName(record._protocolType));
+	Append(":PId");
+	AppendInt(static_cast<int>(record._protocolId));
+	Append("]: ");
+
+	switch (record._protocolType)
+	{
+	case PT_OSCProtocol:
+	case PT_OCAProtocol:
+	case PT_RTTrPMProtocol:
+	case PT_MidiProtocol:
+		Append(GetObjectName(record._protocolType, record._objectId));
+		Append(" | ch");
+		AppendInt(static_cast<int>(record._channel));
+		Append(" rec");
+		AppendInt(static_cast<int>(record._record));
+		break;
+	default:
+		break;
+	}
+
+	if (record.GetInlineValueCount() > 0)
+	{
+		Append(" |");
+		AppendValues(record);
+	}
+
+	return m_buffer;
+}
+
+/**
+ * Method to format the values of a record.
+ *
+ * @param record	The record to format the values of.
+ * @return	The values, each preceded by a space. Values that are not held inline are indicated by " ...".
+ */
+const char* LogLineFormatter::FormatValues(const LogRecord& record)
+{
+	Clear();
+	AppendValues(record);
+
+	return m_buffer;
+}
+
+/**
+ * Method to format the protocol a record was received on, e.g. "OSC:2".
+ *
+ * @param record	The record to format the protocol of.
+ * @return	The zero terminated protocol text, valid until the next call on this formatter.
+ */
+const char* LogLineFormatter::FormatProtocol(const LogRecord& record)
+{
+	Clear();
+	Append(GetProtocolTypeName(record._protocolType));
+	Append(":");
+	AppendInt(static_cast<int>(record._protocolId));
+
+	return m_buffer;
+}
+
+/**
+ * Getter for the length of the text formatted last.
+ *
+ * @return	The count of chars, without termination.
+ */
+int LogLineFormatter::GetLength() const
+{
+	return m_length;
+}
+
+/**
+ * Helper method to convert the text formatted last to a String, e.g. for drawing.
+ *
+ * @return	The text formatted last.
+ */
+String LogLineFormatter::ToString() const
+{
+	return String(CharPointer_UTF8(m_buffer), static_cast<size_t>(m_length));
+}
+
+/**
+ * Helper method to reset the buffer to an empty line.
+ */
+void LogLineFormatter::Clear()
+{
+	m_length = 0;
+	m_buffer[0] = '\0';
+}
+
+/**
+ * Helper method to append a zero terminated text. Text that does not fit is truncated.
+ *
+ * @param text	The text to append.
+ */
+void LogLineFormatter::Append(const char* text)
+{
+	while (*text != '\0' && m_length < FC_BufferSize - 1)
+		m_buffer[m_length++] = *text++;
+
+	m_buffer[m_length] = '\0';
+}
+
+/**
+ * Helper method to append an int in decimal notation.
+ *
+ * @param value	The value to append.
+ */
+void LogLineFormatter::AppendInt(int value)
+{
+	auto result = std::to_chars(m_buffer + m_length, m_buffer + FC_BufferSize - 1, value);
+	if (result.ec == std::errc())
+		m_length = static_cast<int>(result.ptr - m_buffer);
+
+	m_buffer[m_length] = '\0';
+}
+
+/**
+ * Helper method to append a float in fixed notation with six decimals.
+ * Floating point std::to_chars is not available with all supported toolchains, therefor snprintf is used.
+ *
+ * @param value	The value to append.
+ */
+void LogLineFormatter::AppendFloat(float value)
+{
+	auto remaining = FC_BufferSize - m_length;
+	auto written = std::snprintf(m_buffer + m_length, static_cast<size_t>(remaining), "%f", static_cast<double>(value));
+	if (written > 0)
+		m_length += jmin(written, remaining - 1);
+
+	m_buffer[m_length] = '\0';
+}
+
+/**
+ * Helper method to append the inline values of a record, each preceded by a space.
+ *
+ * @param record	The record to append the values of.
+ */
+void LogLineFormatter::AppendValues(const LogRecord& record)
+{
+	auto valueCount = record.GetInlineValueCount();
+	for (int i = 0; i < valueCount; ++i)
+	{
+		Append(" ");
+		if (record._valueType == ROVT_FLOAT)
+			AppendFloat(record._floatValues[i]);
+		else
+			AppendInt(record._intValues[i]);
+	}
+
+	if (valueCount > 0 && record._valueCount > valueCount)
+		Append(" ...");
+}
@@ -0,0 +1,85 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "LogRecord.h"
+
+
+/**
+ * Class LogLineFormatter renders LogRecords into human readable log lines without heap allocation.
+ * The text is written into a fixed size buffer that is reused for every record, numbers are converted
+ * with std::to_chars and protocol and object names are taken from tables that are built once on first use.
+ * The returned text stays valid until the next call on the same formatter, use GetThreadInstance
+ * to get a formatter that is reused by all callers on the current thread.
+ */
+class LogLineFormatter
+{
+public:
+	enum FormatterConstants
+	{
+		FC_BufferSize = 512,	/**< Size of the line buffer, longer lines are truncated. */
+	};
+
+public:
+	LogLineFormatter();
+	~LogLineFormatter();
+
+	//==============================================================================
+	const char* FormatLine(const LogRecord& record);
+	const char* FormatValues(const LogRecord& record);
+	const char* FormatProtocol(const LogRecord& record);
+	int GetLength() const;
+	String ToString() const;
+
+	//==============================================================================
+	static LogLineFormatter& GetThreadInstance();
+	static const char* GetProtocolTypeName(ProtocolType type);
+	static const char* GetObjectName(ProtocolType type, RemoteObjectIdentifier Id);
+
+private:
+	void Clear();
+	void Append(const char* text);
+	void AppendInt(int value);
+	void AppendFloat(float value);
+	void AppendValues(const LogRecord& record);
+
+private:
+	char	m_buffer[FC_BufferSize];	/**< The line buffer, always zero terminated. */
+	int		m_length;					/**< Count of chars currently in the buffer, without termination. */
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LogLineFormatter)
+};
@@ -0,0 +1,119 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "RemoteProtocolBridgeCommon.h"
+
+
+/**
+ * Struct LogRecord is the fixed-size binary representation of a single message that was
+ * handed to the logging by the engine. All values are held inline, so creating and copying
+ * records never involves heap allocation and records can be passed between threads by value.
+ */
+struct LogRecord
+{
+	enum LogRecordConstants
+	{
+		MaxInlineValues = 3,	/**< Max. number of values kept inline (sufficient for x/y/z position data). */
+	};
+
+	//==============================================================================
+	LogRecord() {};
+
+	/**
+	 * Constructor to initialize the record from the data the engine passes to logging targets.
+	 * Values beyond MaxInlineValues are not kept, but _valueCount still reflects the original count.
+	 *
+	 * @param NId			The node id the logging data comes from
+	 * @param SenderPId		The protocol id of the protocol the data was received at
+	 * @param SenderType	The protocol type of the protocol that received the data
+	 * @param Id			The message id of the data
+	 * @param msgData		The actual message data
+	 */
+	LogRecord(NodeId NId, ProtocolId SenderPId, ProtocolType SenderType, RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData)
+		: _timestamp(Time::getMillisecondCounterHiRes()),
+		_nodeId(NId),
+		_protocolId(SenderPId),
+		_protocolType(SenderType),
+		_objectId(Id),
+		_channel(msgData._addrVal._first),
+		_record(msgData._addrVal._second),
+		_valueType(msgData._valType),
+		_valueCount(msgData._valCount),
+		_payloadSize(msgData._payloadSize)
+	{
+		auto inlineCount = GetInlineValueCount();
+		if (msgData._payload && inlineCount > 0)
+		{
+			if (_valueType == ROVT_FLOAT)
+				std::memcpy(_floatValues, msgData._payload, inlineCount * sizeof(float));
+			else if (_valueType == ROVT_INT)
+				std::memcpy(_intValues, msgData._payload, inlineCount * sizeof(int));
+		}
+	};
+
+	/**
+	 * Getter for the number of values that are actually available inline in this record.
+	 *
+	 * @return	The number of valid entries in _floatValues or _intValues, depending on _valueType.
+	 */
+	int GetInlineValueCount() const
+	{
+		if (_valueType != ROVT_FLOAT && _valueType != ROVT_INT)
+			return 0;
+
+		return jmin(static_cast<int>(_valueCount), static_cast<int>(MaxInlineValues));
+	};
+
+
+	//==============================================================================
+	double					_timestamp{ 0.0 };					/**< Time of reception in ms, as delivered by Time::getMillisecondCounterHiRes. */
+	NodeId					_nodeId{ 0 };						/**< Id of the node the message was received in. */
+	ProtocolId				_protocolId{ 0 };					/**< Id of the protocol the message was received on. */
+	ProtocolType			_protocolType{ PT_Invalid };		/**< Type of the protocol the message was received on. */
+	RemoteObjectIdentifier	_objectId{ ROI_Invalid };			/**< Remote object the message refers to. */
+	ChannelId				_channel{ 0 };						/**< Channel addressing value of the message. */
+	RecordId				_record{ 0 };						/**< Record addressing value of the message. */
+	RemoteObjectValueType	_valueType{};						/**< Type of the values in the message. */
+	uint16					_valueCount{ 0 };					/**< Count of values in the original message (may exceed MaxInlineValues). */
+	uint32					_payloadSize{ 0 };					/**< Payload size of the original message in bytes. */
+	union
+	{
+		float				_floatValues[MaxInlineValues]{};		/**< Inline float values, valid if _valueType is ROVT_FLOAT. */
+		int					_intValues[MaxInlineValues];		/**< Inline int values, valid if _valueType is ROVT_INT. */
+	};
+};
@@ -0,0 +1,439 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#include "LogRecordCapture.h"
+
+
+static_assert(std::is_trivially_copyable<LogRecord>::value, "LogRecord is written to capture files as raw binary data");
+static_assert(sizeof(LogRecordCaptureHeader) <= LogRecordCaptureHeader::HeaderSize, "Capture header exceeds its reserved size");
+
+
+// **************************************************************************************
+//    class LogRecordCaptureWriter
+// **************************************************************************************
+/**
+ * Constructor
+ */
+LogRecordCaptureWriter::LogRecordCaptureWriter()
+	: Thread("LogRecordCaptureWriter"),
+	m_segmentStart(0),
+	m_writePosition(0)
+{
+	m_ring = std::make_unique<LogRecordRing>(CWC_RingCapacity);
+}
+
+/**
+ * Destructor. A running capture is finished properly.
+ */
+LogRecordCaptureWriter::~LogRecordCaptureWriter()
+{
+	Stop();
+}
+
+/**
+ * Method to start capturing to the given file. An existing file is overwritten.
+ *
+ * @param captureFile	The file to write the capture to.
+ * @return	True if the file could be prepared and capturing was started.
+ */
+bool LogRecordCaptureWriter::Start(const File& captureFile)
+{
+	if (IsCapturing())
+		return false;
+
+	// discard records that were pushed while the previous capture was stopped
+	LogRecord staleRecord;
+	while (m_ring->Pop(staleRecord)) {}
+
+	if (!captureFile.getParentDirectory().createDirectory().wasOk() || !captureFile.deleteFile())
+		return false;
+
+	m_captureFile = captureFile;
+	m_writePosition = 0;
+	m_writtenRecordCount.store(0);
+
+	if (!MapSegment(0))
+		return false;
+
+	LogRecordCaptureHeader header;
+	header._startTime = Time::currentTimeMillis();
+	header._startTimestamp = Time::getMillisecondCounterHiRes();
+
+	char headerBlock[LogRecordCaptureHeader::HeaderSize]{};
+	std::memcpy(headerBlock, &header, sizeof(header));
+	Write(headerBlock, sizeof(headerBlock));
+
+	m_capturing.store(true);
+	startThread();
+
+	return true;
+}
+
+/**
+ * Method to stop capturing. All records that are still queued are written,
+ * the mapping is released and the file is truncated to the written size.
+ */
+void LogRecordCaptureWriter::Stop()
+{
+	if (!m_capturing.exchange(false))
+		return;
+
+	stopThread(1000);
+
+	m_segment.reset();
+
+	FileOutputStream out(m_captureFile);
+	if (out.openedOk())
+	{
+		out.setPosition(m_writePosition);
+		out.truncate();
+	}
+}
+
+/**
+ * Getter for the capturing state.
+ *
+ * @return	True if records are currently accepted and written.
+ */
+bool LogRecordCaptureWriter::IsCapturing() const
+{
+	return m_capturing.load(std::memory_order_relaxed);
+}
+
+/**
+ * Method to queue a record for writing. This may be called from any thread and does not block.
+ *
+ * @param record	The record to write to the capture.
+ * @return	True if the record was queued, false if not capturing or the queue was full.
+ */
+bool LogRecordCaptureWriter::Push(const LogRecord& record)
+{
+	if (!IsCapturing())
+		return false;
+
+	return m_ring->Push(record);
+}
+
+/**
+ * Getter for the file that is or was last captured to.
+ *
+ * @return	The capture file.
+ */
+const File& LogRecordCaptureWriter::GetCaptureFile() const
+{
+	return m_captureFile;
+}
+
+/**
+ * Getter for the number of records written to the current capture.
+ *
+ * @return	The written record count.
+ */
+uint64 LogRecordCaptureWriter::GetWrittenRecordCount() const
+{
+	return m_writtenRecordCount.load(std::memory_order_relaxed);
+}
+
+/**
+ * Getter for the number of records that could not be captured because
+ * the writer thread did not keep up.
+ *
+ * @return	The dropped record count.
+ */
+uint64 LogRecordCaptureWriter::GetDroppedCount() const
+{
+	return m_ring->GetDroppedCount();
+}
+
+/**
+ * Thread method that moves the queued records to the mapped file segments.
+ */
+void LogRecordCaptureWriter::run()
+{
+	LogRecord record;
+
+	while (!threadShouldExit())
+	{
+		auto writtenAny = false;
+		while (m_ring->Pop(record))
+		{
+			Write(&record, sizeof(record));
+			m_writtenRecordCount.fetch_add(1, std::memory_order_relaxed);
+			writtenAny = true;
+		}
+
+		if (!writtenAny)
+			wait(CWC_IdleWaitMs);
+	}
+
+	// write what has been queued until capturing was stopped
+	while (m_ring->Pop(record))
+	{
+		Write(&record, sizeof(record));
+		m_writtenRecordCount.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+/**
+ * Helper method to grow the capture file by one segment and map that segment for writing.
+ *
+ * @param segmentStart	The file position the new segment starts at.
+ * @return	True if the file was grown and the segment is mapped.
+ */
+bool LogRecordCaptureWriter::MapSegment(int64 segmentStart)
+{
+	m_segment.reset();
+
+	{
+		// the mapped range has to exist in the file, so grow the file first
+		FileOutputStream out(m_captureFile);
+		if (!out.openedOk())
+			return false;
+		out.setPosition(segmentStart + CWC_SegmentSize - 1);
+		out.writeByte(0);
+		out.flush();
+	}
+
+	m_segment = std::make_unique<MemoryMappedFile>(m_captureFile, Range<int64>(segmentStart, segmentStart + CWC_SegmentSize), MemoryMappedFile::readWrite, false);
+	if (m_segment->getData() == nullptr)
+	{
+		m_segment.reset();
+		return false;
+	}
+
+	m_segmentStart = segmentStart;
+
+	return true;
+}
+
+/**
+ * Helper method to append data at the current write position. Data that does not fit
+ * into the current segment is continued in a newly mapped one.
+ *
+ * @param data	The data to append.
+ * @param size	The size of the data in bytes.
+ */
+void LogRecordCaptureWriter::Write(const void* data, size_t size)
+{
+	auto src = static_cast<const char*>(data);
+
+	while (size > 0)
+	{
+		auto segmentEnd = m_segmentStart + CWC_SegmentSize;
+		if (!m_segment || m_writePosition >= segmentEnd)
+		{
+			if (!MapSegment(m_writePosition))
+				return;
+			segmentEnd = m_segmentStart + CWC_SegmentSize;
+		}
+
+		auto chunkSize = jmin(size, static_cast<size_t>(segmentEnd - m_writePosition));
+		auto mappedBase = static_cast<char*>(m_segment->getData()) - m_segment->getRange().getStart();
+		std::memcpy(mappedBase + m_writePosition, src, chunkSize);
+
+		m_writePosition += static_cast<int64>(chunkSize);
+		src += chunkSize;
+		size -= chunkSize;
+	}
+}
+
+
+// **************************************************************************************
+//    class LogRecordReplayer
+// **************************************************************************************
+/**
+ * Constructor
+ */
+LogRecordReplayer::LogRecordReplayer()
+	: Thread("LogRecordReplayer"),
+	m_target(nullptr),
+	m_speedFactor(1.0),
+	m_recordCount(0)
+{
+}
+
+/**
+ * Destructor
+ */
+LogRecordReplayer::~LogRecordReplayer()
+{
+	Stop();
+}
+
+/**
+ * Method to start replaying a capture file.
+ *
+ * @param captureFile	The capture file to replay.
+ * @param target		The record target the records are delivered to.
+ * @param speedFactor	Replay speed relative to the original timing. 0 replays as fast as possible.
+ * @return	True if the file is a valid capture and replaying was started.
+ */
+bool LogRecordReplayer::Start(const File& captureFile, LogRecordTarget_Interface* target, double speedFactor)
+{
+	Stop();
+
+	if (!target)
+		return false;
+
+	m_captureMapping = std::make_unique<MemoryMappedFile>(captureFile, MemoryMappedFile::readOnly);
+	if (m_captureMapping->getData() == nullptr || m_captureMapping->getSize() < LogRecordCaptureHeader::HeaderSize)
+	{
+		m_captureMapping.reset();
+		return false;
+	}
+
+	LogRecordCaptureHeader header;
+	std::memcpy(&header, m_captureMapping->getData(), sizeof(header));
+	if (header._magic != LogRecordCaptureHeader::MagicNumber
+		|| header._version != LogRecordCaptureHeader::FormatVersion
+		|| header._recordSize != sizeof(LogRecord))
+	{
+		m_captureMapping.reset();
+		return false;
+	}
+
+	m_target = target;
+	m_speedFactor = jmax(0.0, speedFactor);
+	m_recordCount = static_cast<uint64>(m_captureMapping->getSize() - LogRecordCaptureHeader::HeaderSize) / sizeof(LogRecord);
+	m_replayedRecordCount.store(0);
+	m_replayDurationMs.store(0.0);
+
+	startThread();
+
+	return true;
+}
+
+/**
+ * Method to stop replaying and release the capture file.
+ */
+void LogRecordReplayer::Stop()
+{
+	stopThread(1000);
+	m_captureMapping.reset();
+}
+
+/**
+ * Getter for the replaying state.
+ *
+ * @return	True while records are being replayed.
+ */
+bool LogRecordReplayer::IsReplaying() const
+{
+	return isThreadRunning();
+}
+
+/**
+ * Getter for the replay progress.
+ *
+ * @return	The share of records replayed, in range 0..1.
+ */
+double LogRecordReplayer::GetProgress() const
+{
+	if (m_recordCount == 0)
+		return 0.0;
+
+	return static_cast<double>(m_replayedRecordCount.load(std::memory_order_relaxed)) / static_cast<double>(m_recordCount);
+}
+
+/**
+ * Getter for the number of records delivered to the target so far.
+ *
+ * @return	The replayed record count.
+ */
+uint64 LogRecordReplayer::GetReplayedRecordCount() const
+{
+	return m_replayedRecordCount.load(std::memory_order_relaxed);
+}
+
+/**
+ * Getter for the rate records were delivered to the target with. When replaying as fast as
+ * possible, this is the throughput the target is able to handle.
+ *
+ * @return	The replay rate in records per second.
+ */
+double LogRecordReplayer::GetReplayedRecordsPerSecond() const
+{
+	auto durationMs = m_replayDurationMs.load(std::memory_order_relaxed);
+	if (durationMs <= 0.0)
+		return 0.0;
+
+	return static_cast<double>(m_replayedRecordCount.load(std::memory_order_relaxed)) * 1000.0 / durationMs;
+}
+
+/**
+ * Thread method that delivers the captured records to the target, timed by their original timestamps.
+ */
+void LogRecordReplayer::run()
+{
+	auto records = static_cast<const char*>(m_captureMapping->getData()) + LogRecordCaptureHeader::HeaderSize;
+
+	auto replayStartMs = Time::getMillisecondCounterHiRes();
+	auto firstTimestamp = 0.0;
+
+	LogRecord record;
+	for (uint64 i = 0; i < m_recordCount && !threadShouldExit(); ++i)
+	{
+		std::memcpy(&record, records + i * sizeof(LogRecord), sizeof(LogRecord));
+
+		// unused space at the end of a capture that was not finished properly
+		if (record._timestamp <= 0.0)
+			break;
+
+		if (i == 0)
+			firstTimestamp = record._timestamp;
+
+		if (m_speedFactor > 0.0)
+		{
+			auto dueMs = replayStartMs + (record._timestamp - firstTimestamp) / m_speedFactor;
+			for (auto remainingMs = dueMs - Time::getMillisecondCounterHiRes(); remainingMs > 0.0; remainingMs = dueMs - Time::getMillisecondCounterHiRes())
+			{
+				if (threadShouldExit())
+					return;
+
+				if (remainingMs > 2.0)
+					wait(static_cast<int>(remainingMs) - 1);
+				else
+					Thread::yield();
+			}
+		}
+
+		// the target retains and evicts records by their age, so they are delivered as received now
+		record._timestamp = Time::getMillisecondCounterHiRes();
+
+		m_target->AddLogRecord(record);
+
+		m_replayedRecordCount.fetch_add(1, std::memory_order_relaxed);
+		m_replayDurationMs.store(Time::getMillisecondCounterHiRes() - replayStartMs, std::memory_order_relaxed);
+	}
+}
@@ -0,0 +1,150 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "LogRecordRing.h"
+#include "../LogRecordTarget_Interface.h"
+
+
+/**
+ * Header at the beginning of every traffic capture file. It is followed by the
+ * captured LogRecord entries, stored binary as they are held in memory.
+ */
+struct LogRecordCaptureHeader
+{
+	enum CaptureConstants
+	{
+		MagicNumber		= 0x50434252,	/**< 'RBCP' in little endian byte order, marks a file as traffic capture. */
+		FormatVersion	= 2,			/**< Version of the capture file layout. */
+		HeaderSize		= 64,			/**< Fixed size reserved for the header in the file. */
+	};
+
+	uint32	_magic{ MagicNumber };				/**< Must be MagicNumber for a valid capture. */
+	uint32	_version{ FormatVersion };			/**< The layout version the capture was written with. */
+	uint32	_recordSize{ sizeof(LogRecord) };	/**< Size of a single record, to detect captures of incompatible builds. */
+	uint32	_reserved{ 0 };						/**< Unused, for alignment. */
+	int64	_startTime{ 0 };					/**< Wall clock time the capture was started at, in ms since epoch. */
+	double	_startTimestamp{ 0.0 };				/**< Record timestamp base, as delivered by Time::getMillisecondCounterHiRes at capture start. */
+};
+
+/**
+ * Class LogRecordCaptureWriter streams log records to a binary capture file.
+ * Records are pushed into a lock-free ring from any thread and written by a background
+ * thread through a memory mapped append segment of the file, so capturing never blocks
+ * the engine threads with file io.
+ */
+class LogRecordCaptureWriter : private Thread
+{
+public:
+	enum CaptureWriterConstants
+	{
+		CWC_RingCapacity	= 65536,			/**< Number of records that can be buffered until the writer thread catches up. */
+		CWC_SegmentSize		= 4 * 1024 * 1024,	/**< Size of the file segments that are memory mapped for appending. */
+		CWC_IdleWaitMs		= 5,				/**< Time the writer thread sleeps when there is nothing to write. */
+	};
+
+public:
+	LogRecordCaptureWriter();
+	~LogRecordCaptureWriter();
+
+	//==============================================================================
+	bool Start(const File& captureFile);
+	void Stop();
+	bool IsCapturing() const;
+
+	//==============================================================================
+	bool Push(const LogRecord& record);
+
+	//==============================================================================
+	const File& GetCaptureFile() const;
+	uint64 GetWrittenRecordCount() const;
+	uint64 GetDroppedCount() const;
+
+private:
+	void run() override;
+
+	bool MapSegment(int64 segmentStart);
+	void Write(const void* data, size_t size);
+
+private:
+	std::unique_ptr<LogRecordRing>		m_ring;					/**< Ring the producers push records into. */
+	std::atomic<bool>					m_capturing{ false };	/**< Flag to indicate if records are accepted. */
+
+	File								m_captureFile;			/**< The file currently captured to. */
+	std::unique_ptr<MemoryMappedFile>	m_segment;				/**< The currently mapped append segment of the file. */
+	int64								m_segmentStart;			/**< File position the current segment starts at. */
+	int64								m_writePosition;		/**< File position the next data is written to. */
+
+	std::atomic<uint64>					m_writtenRecordCount{ 0 };	/**< Count of records written to the current capture file. */
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LogRecordCaptureWriter)
+};
+
+/**
+ * Class LogRecordReplayer reads a traffic capture file and feeds its records to a record target
+ * on a background thread, either with the original timing, accelerated, or as fast as possible.
+ */
+class LogRecordReplayer : private Thread
+{
+public:
+	LogRecordReplayer();
+	~LogRecordReplayer();
+
+	//==============================================================================
+	bool Start(const File& captureFile, LogRecordTarget_Interface* target, double speedFactor);
+	void Stop();
+	bool IsReplaying() const;
+
+	//==============================================================================
+	double GetProgress() const;
+	uint64 GetReplayedRecordCount() const;
+	double GetReplayedRecordsPerSecond() const;
+
+private:
+	void run() override;
+
+private:
+	std::unique_ptr<MemoryMappedFile>	m_captureMapping;	/**< Read only mapping of the capture file that is replayed. */
+	LogRecordTarget_Interface*			m_target;			/**< The target the replayed records are delivered to. */
+	double								m_speedFactor;		/**< Replay speed relative to original timing. 0 replays as fast as possible. */
+	uint64								m_recordCount;		/**< Number of records in the capture. */
+
+	std::atomic<uint64>					m_replayedRecordCount{ 0 };		/**< Records delivered so far. */
+	std::atomic<double>					m_replayDurationMs{ 0.0 };		/**< Time spent for replaying so far. */
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LogRecordReplayer)
+};
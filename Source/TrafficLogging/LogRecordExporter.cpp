@@ -0,0 +1,381 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#include "LogRecordExporter.h"
+
+#include "LogLineFormatter.h"
+
+#include <charconv>
+#include <cstdio>
+#include <set>
+
+
+// **************************************************************************************
+//    class LogRecordExporter
+// **************************************************************************************
+/**
+ * Constructor
+ */
+LogRecordExporter::LogRecordExporter()
+	: Thread("LogRecordExporter"),
+	m_format(EF_Csv),
+	m_startTime(0),
+	m_startTimestamp(0.0)
+{
+}
+
+/**
+ * Destructor. A running export is cancelled.
+ */
+LogRecordExporter::~LogRecordExporter()
+{
+	Stop();
+}
+
+/**
+ * Method to start exporting the given records. The records are taken over by the exporter, so the caller
+ * only has to copy them out of its store once. An existing target is overwritten.
+ *
+ * @param records	The records to export, in order of reception.
+ * @param target	The file (EF_Csv) or directory (EF_NumPyColumns) to export to.
+ * @param format	The format to export in.
+ * @return	True if the export was started, false if an export is still running.
+ */
+bool LogRecordExporter::Start(std::vector<LogRecord>&& records, const File& target, ExportFormat format)
+{
+	if (IsExporting())
+		return false;
+
+	// join the thread of the previous export, it may still be winding down after setting its state
+	stopThread(2000);
+
+	m_records = std::move(records);
+	m_target = target;
+	m_format = format;
+	m_startTime = Time::currentTimeMillis();
+	m_startTimestamp = Time::getMillisecondCounterHiRes();
+
+	auto columnCount = (m_format == EF_NumPyColumns) ? int(EC_NumPyColumnCount) : 1;
+	m_totalCount = static_cast<uint64>(m_records.size()) * static_cast<uint64>(columnCount);
+	m_writtenCount.store(0);
+	m_state.store(ES_Running);
+
+	startThread();
+
+	return true;
+}
+
+/**
+ * Method to cancel a running export. Partially written output is removed.
+ */
+void LogRecordExporter::Stop()
+{
+	stopThread(2000);
+}
+
+/**
+ * Getter for the exporting state.
+ *
+ * @return	True while the export is in progress.
+ */
+bool LogRecordExporter::IsExporting() const
+{
+	return m_state.load() == ES_Running;
+}
+
+/**
+ * Getter for the state of the last export.
+ *
+ * @return	The state.
+ */
+LogRecordExporter::ExportState LogRecordExporter::GetState() const
+{
+	return static_cast<ExportState>(m_state.load());
+}
+
+/**
+ * Getter for the export progress.
+ *
+ * @return	The share of the export that is written, in range 0..1.
+ */
+double LogRecordExporter::GetProgress() const
+{
+	if (m_totalCount == 0)
+		return IsExporting() ? 0.0 : 1.0;
+
+	return static_cast<double>(m_writtenCount.load(std::memory_order_relaxed)) / static_cast<double>(m_totalCount);
+}
+
+/**
+ * Getter for the number of records of the last export.
+ *
+ * @return	The record count.
+ */
+uint64 LogRecordExporter::GetRecordCount() const
+{
+	return static_cast<uint64>(m_records.size());
+}
+
+/**
+ * Getter for the target of the last export.
+ *
+ * @return	The file or directory exported to.
+ */
+const File& LogRecordExporter::GetTarget() const
+{
+	return m_target;
+}
+
+/**
+ * Helper method to get the file extension that is used for the target of a format.
+ *
+ * @param format	The export format.
+ * @return	The extension including the dot, empty for formats that export to a directory.
+ */
+const char* LogRecordExporter::GetFileExtension(ExportFormat format)
+{
+	return (format == EF_Csv) ? ".csv" : "";
+}
+
+/**
+ * Reimplemented from Thread. Writes the snapshot in the selected format and sets the resulting state.
+ */
+void LogRecordExporter::run()
+{
+	auto written = (m_format == EF_NumPyColumns) ? WriteNumPyColumns() : WriteCsv();
+
+	if (threadShouldExit() || !written)
+	{
+		if (m_target.isDirectory())
+			m_target.deleteRecursively();
+		else
+			m_target.deleteFile();
+
+		m_state.store(threadShouldExit() ? ES_Cancelled : ES_Failed);
+	}
+	else
+	{
+		m_state.store(ES_Finished);
+	}
+}
+
+/**
+ * Helper method to write the snapshot as one CSV file.
+ * Columns are time_ms, node, protocol, protocol_type, object, channel, record, value_count, value1..value3.
+ * Values that are not held inline are left empty.
+ *
+ * @return	True if the file was written completely.
+ */
+bool LogRecordExporter::WriteCsv()
+{
+	if (!m_target.getParentDirectory().createDirectory().wasOk() || !m_target.deleteFile())
+		return false;
+
+	FileOutputStream out(m_target, EC_WriteBufferSize);
+	if (!out.openedOk())
+		return false;
+
+	out.writeText("time_ms,node,protocol,protocol_type,object,channel,record,value_count,value1,value2,value3\n", false, false, nullptr);
+
+	char line[512];
+	auto appendInt = [&line](char* pos, int value) { return std::to_chars(pos, line + sizeof(line), value).ptr; };
+	auto appendText = [&line](char* pos, const char* text) { while (*text != '\0' && pos < line + sizeof(line) - 1) *pos++ = *text++; return pos; };
+	// floating point std::to_chars is not available with all supported toolchains, therefor snprintf is used
+	auto appendFloat = [&line](char* pos, const char* format, double value) { auto remaining = static_cast<int>(line + sizeof(line) - pos); auto written = std::snprintf(pos, static_cast<size_t>(remaining), format, value); return written > 0 ? pos + jmin(written, remaining - 1) : pos; };
+
+	uint64 writtenCount = 0;
+	for (auto const& record : m_records)
+	{
+		if (threadShouldExit())
+			return false;
+
+		auto pos = appendFloat(line, "%.3f", GetWallClockTime(record));
+		*pos++ = ',';
+		pos = appendInt(pos, static_cast<int>(record._nodeId));
+		*pos++ = ',';
+		pos = appendInt(pos, static_cast<int>(record._protocolId));
+		*pos++ = ',';
+		pos = appendText(pos, LogLineFormatter::GetProtocolTypeName(record._protocolType));
+		*pos++ = ',';
+		pos = appendText(pos, LogLineFormatter::GetObjectName(PT_Invalid, record._objectId));
+		*pos++ = ',';
+		pos = appendInt(pos, static_cast<int>(record._channel));
+		*pos++ = ',';
+		pos = appendInt(pos, static_cast<int>(record._record));
+		*pos++ = ',';
+		pos = appendInt(pos, static_cast<int>(record._valueCount));
+
+		auto valueCount = record.GetInlineValueCount();
+		for (int i = 0; i < LogRecord::MaxInlineValues; ++i)
+		{
+			*pos++ = ',';
+			if (i >= valueCount)
+				continue;
+			if (record._valueType == ROVT_FLOAT)
+				pos = appendFloat(pos, "%.9g", static_cast<double>(record._floatValues[i]));
+			else
+				pos = appendInt(pos, record._intValues[i]);
+		}
+		*pos++ = '\n';
+
+		if (!out.write(line, static_cast<size_t>(pos - line)))
+			return false;
+
+		if ((++writtenCount % EC_ColumnChunkSize) == 0)
+			m_writtenCount.store(writtenCount, std::memory_order_relaxed);
+	}
+
+	out.flush();
+	m_writtenCount.store(writtenCount, std::memory_order_relaxed);
+
+	return !out.getStatus().failed();
+}
+
+/**
+ * Helper method to write the snapshot as a directory of NumPy arrays, one per column.
+ * Ids are written as int32, time and values as float64 with NaN for values that are not held inline.
+ * The names of the protocol types and objects that occur are written to protocol_types.csv and objects.csv.
+ *
+ * @return	True if all files were written completely.
+ */
+bool LogRecordExporter::WriteNumPyColumns()
+{
+	if (m_target.exists() && !m_target.deleteRecursively())
+		return false;
+	if (!m_target.createDirectory().wasOk())
+		return false;
+
+	auto nan = std::numeric_limits<double>::quiet_NaN();
+	auto getValue = [nan](const LogRecord& record, int i)
+	{
+		if (i >= record.GetInlineValueCount())
+			return nan;
+		return (record._valueType == ROVT_FLOAT) ? static_cast<double>(record._floatValues[i]) : static_cast<double>(record._intValues[i]);
+	};
+
+	auto written = WriteNumPyColumn<double>("time_ms", "f8", 0, [this](const LogRecord& r) { return GetWallClockTime(r); })
+		&& WriteNumPyColumn<int32>("node", "i4", 1, [](const LogRecord& r) { return static_cast<int32>(r._nodeId); })
+		&& WriteNumPyColumn<int32>("protocol", "i4", 2, [](const LogRecord& r) { return static_cast<int32>(r._protocolId); })
+		&& WriteNumPyColumn<int32>("protocol_type", "i4", 3, [](const LogRecord& r) { return static_cast<int32>(r._protocolType); })
+		&& WriteNumPyColumn<int32>("object", "i4", 4, [](const LogRecord& r) { return static_cast<int32>(r._objectId); })
+		&& WriteNumPyColumn<int32>("channel", "i4", 5, [](const LogRecord& r) { return static_cast<int32>(r._channel); })
+		&& WriteNumPyColumn<int32>("record", "i4", 6, [](const LogRecord& r) { return static_cast<int32>(r._record); })
+		&& WriteNumPyColumn<int32>("value_count", "i4", 7, [](const LogRecord& r) { return static_cast<int32>(r._valueCount); })
+		&& WriteNumPyColumn<double>("value1", "f8", 8, [getValue](const LogRecord& r) { return getValue(r, 0); })
+		&& WriteNumPyColumn<double>("value2", "f8", 9, [getValue](const LogRecord& r) { return getValue(r, 1); })
+		&& WriteNumPyColumn<double>("value3", "f8", 10, [getValue](const LogRecord& r) { return getValue(r, 2); });
+	if (!written)
+		return false;
+
+	std::set<int> protocolTypes;
+	std::set<int> objects;
+	for (auto const& record : m_records)
+	{
+		protocolTypes.insert(static_cast<int>(record._protocolType));
+		objects.insert(static_cast<int>(record._objectId));
+	}
+
+	String protocolTypeNames("protocol_type,name\n");
+	for (auto protocolType : protocolTypes)
+		protocolTypeNames << protocolType << "," << LogLineFormatter::GetProtocolTypeName(static_cast<ProtocolType>(protocolType)) << "\n";
+
+	String objectNames("object,name\n");
+	for (auto object : objects)
+		objectNames << object << "," << LogLineFormatter::GetObjectName(PT_Invalid, static_cast<RemoteObjectIdentifier>(object)) << "\n";
+
+	return m_target.getChildFile("protocol_types.csv").replaceWithText(protocolTypeNames)
+		&& m_target.getChildFile("objects.csv").replaceWithText(objectNames);
+}
+
+/**
+ * Helper method to write a single column of the snapshot as NumPy .npy file (format version 1.0).
+ * Values are converted and written in chunks, to keep the progress up to date and stay responsive to cancelling.
+ *
+ * @param columnName	The column name, used as file name.
+ * @param dtype			The NumPy type code without byte order, e.g. "f8".
+ * @param columnIndex	The index of the column in the export, for progress reporting.
+ * @param getValue		Function that gets the column value of a record.
+ * @return	True if the file was written completely.
+ */
+template<typename ValueType>
+bool LogRecordExporter::WriteNumPyColumn(const String& columnName, const char* dtype, int columnIndex, std::function<ValueType(const LogRecord&)> getValue)
+{
+	auto columnFile = m_target.getChildFile(columnName + ".npy");
+	FileOutputStream out(columnFile, EC_WriteBufferSize);
+	if (!out.openedOk())
+		return false;
+
+	// magic, version 1.0, header length and a python dict literal, padded so the data starts 64 byte aligned
+	String header;
+	header << "{'descr': '" << (ByteOrder::isBigEndian() ? ">" : "<") << dtype << "', 'fortran_order': False, 'shape': (" << String(static_cast<uint64>(m_records.size())) << ",), }";
+	auto paddedHeaderLength = ((10 + header.length() + 1 + 63) / 64) * 64 - 10;
+	header = header.paddedRight(' ', paddedHeaderLength - 1) + "\n";
+
+	const char magic[] = { '\x93', 'N', 'U', 'M', 'P', 'Y', 1, 0 };
+	out.write(magic, sizeof(magic));
+	out.writeShort(static_cast<short>(paddedHeaderLength));
+	out.write(header.toRawUTF8(), static_cast<size_t>(paddedHeaderLength));
+
+	ValueType chunk[EC_ColumnChunkSize];
+	auto baseCount = static_cast<uint64>(columnIndex) * static_cast<uint64>(m_records.size());
+	for (size_t begin = 0; begin < m_records.size(); begin += EC_ColumnChunkSize)
+	{
+		if (threadShouldExit())
+			return false;
+
+		auto end = jmin(begin + static_cast<size_t>(EC_ColumnChunkSize), m_records.size());
+		for (auto i = begin; i < end; ++i)
+			chunk[i - begin] = getValue(m_records[i]);
+
+		if (!out.write(chunk, (end - begin) * sizeof(ValueType)))
+			return false;
+
+		m_writtenCount.store(baseCount + end, std::memory_order_relaxed);
+	}
+
+	out.flush();
+
+	return !out.getStatus().failed();
+}
+
+/**
+ * Helper method to convert the reception timestamp of a record to wall clock time.
+ *
+ * @param record	The record to get the time of.
+ * @return	The time of reception in ms since epoch.
+ */
+double LogRecordExporter::GetWallClockTime(const LogRecord& record) const
+{
+	return static_cast<double>(m_startTime) + (record._timestamp - m_startTimestamp);
+}
@@ -0,0 +1,112 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "LogRecord.h"
+
+
+/**
+ * Class LogRecordExporter writes a snapshot of log records column-oriented to disk for offline analysis,
+ * either as a single CSV file or as a directory with one NumPy .npy array per column.
+ * The export runs on a background thread and reports its progress, so it never blocks the message thread.
+ */
+class LogRecordExporter : private Thread
+{
+public:
+	enum ExportFormat
+	{
+		EF_Csv = 1,			/**< One CSV file with a header line and one line per record. */
+		EF_NumPyColumns,	/**< One directory with a .npy file per column, e.g. for np.load into a pandas DataFrame. */
+	};
+
+	enum ExportState
+	{
+		ES_Idle = 0,	/**< No export was started yet. */
+		ES_Running,		/**< The export is in progress. */
+		ES_Finished,	/**< The last export was completed. */
+		ES_Failed,		/**< The last export could not be written. */
+		ES_Cancelled,	/**< The last export was stopped before completion. */
+	};
+
+	enum ExporterConstants
+	{
+		EC_WriteBufferSize	= 1024 * 1024,	/**< Size of the buffer file output goes through. */
+		EC_ColumnChunkSize	= 4096,			/**< Number of column values that are converted and written at once. */
+		EC_NumPyColumnCount	= 11,			/**< Number of columns written by EF_NumPyColumns. */
+	};
+
+public:
+	LogRecordExporter();
+	~LogRecordExporter();
+
+	//==============================================================================
+	bool Start(std::vector<LogRecord>&& records, const File& target, ExportFormat format);
+	void Stop();
+	bool IsExporting() const;
+
+	//==============================================================================
+	ExportState GetState() const;
+	double GetProgress() const;
+	uint64 GetRecordCount() const;
+	const File& GetTarget() const;
+
+	//==============================================================================
+	static const char* GetFileExtension(ExportFormat format);
+
+private:
+	void run() override;
+
+	bool WriteCsv();
+	bool WriteNumPyColumns();
+	template<typename ValueType>
+	bool WriteNumPyColumn(const String& columnName, const char* dtype, int columnIndex, std::function<ValueType(const LogRecord&)> getValue);
+
+	double GetWallClockTime(const LogRecord& record) const;
+
+private:
+	std::vector<LogRecord>		m_records;				/**< Snapshot of the records to export, owned by the export thread while running. */
+	File						m_target;				/**< The file or directory exported to. */
+	ExportFormat				m_format;				/**< The format exported in. */
+	int64						m_startTime;			/**< Wall clock time in ms since epoch the snapshot was taken at. */
+	double						m_startTimestamp;		/**< Record timestamp that corresponds to m_startTime. */
+
+	std::atomic<int>			m_state{ ES_Idle };		/**< The ExportState of the last export. */
+	std::atomic<uint64>			m_writtenCount{ 0 };	/**< Count of values written so far, records times written columns. */
+	uint64						m_totalCount{ 0 };		/**< Count of values to write in total. */
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LogRecordExporter)
+};
@@ -0,0 +1,210 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#include "LogRecordFilter.h"
+
+#include "ProcessingEngine/ProcessingEngineConfig.h"
+
+
+// **************************************************************************************
+//    class LogRecordFilter
+// **************************************************************************************
+/**
+ * Constructor. Initially no dimension is filtered and all messages pass.
+ */
+LogRecordFilter::LogRecordFilter()
+	: m_activeDimensions(0)
+{
+	Clear();
+}
+
+/**
+ * Destructor
+ */
+LogRecordFilter::~LogRecordFilter()
+{
+}
+
+/**
+ * Method to set the selection for one dimension from user input.
+ * Nodes, protocols, channels and records are given as numbers and ranges, e.g. "1,4,6,8-12".
+ * Objects are given by their short description or numeric id, separated by ',' or ';'.
+ * An empty text removes the filter for the dimension.
+ *
+ * @param dimension		The dimension to set the selection for.
+ * @param selectionText	The user input to compile.
+ * @return	True if the text was valid and the selection was applied, false if it could not be parsed.
+ */
+bool LogRecordFilter::SetFilter(FilterDimension dimension, const String& selectionText)
+{
+	if (dimension < FD_Node || dimension >= FD_MAX)
+		return false;
+
+	SelectionBits bits;
+	if (selectionText.trim().isEmpty())
+	{
+		Store(dimension, bits, false);
+		return true;
+	}
+
+	auto parsed = (dimension == FD_Object) ? ParseObjects(selectionText, bits) : ParseRanges(selectionText, bits);
+	if (!parsed)
+		return false;
+
+	Store(dimension, bits, true);
+
+	return true;
+}
+
+/**
+ * Method to remove the selections of all dimensions.
+ */
+void LogRecordFilter::Clear()
+{
+	m_activeDimensions.store(0);
+
+	for (auto& dimensionBits : m_bits)
+		for (auto& word : dimensionBits)
+			word.store(0, std::memory_order_relaxed);
+}
+
+/**
+ * Getter for the filtering state.
+ *
+ * @return	True if at least one dimension is filtered.
+ */
+bool LogRecordFilter::IsActive() const
+{
+	return m_activeDimensions.load(std::memory_order_relaxed) != 0;
+}
+
+/**
+ * Helper method to write the compiled selection of a dimension to the bitset read by ::Matches.
+ *
+ * @param dimension	The dimension to write.
+ * @param bits		The compiled selection.
+ * @param active	True if the dimension is to be filtered.
+ */
+void LogRecordFilter::Store(FilterDimension dimension, const SelectionBits& bits, bool active)
+{
+	// disable the dimension while its words are rewritten, to not reject everything in between
+	m_activeDimensions.fetch_and(~(1u << dimension));
+
+	for (int i = 0; i < FC_WordCount; ++i)
+	{
+		uint64 word = 0;
+		for (int j = 0; j < 64; ++j)
+			if (bits[i * 64 + j])
+				word |= uint64(1) << j;
+		m_bits[dimension][i].store(word, std::memory_order_relaxed);
+	}
+
+	if (active)
+		m_activeDimensions.fetch_or(1u << dimension);
+}
+
+/**
+ * Helper method to parse number and range input like "1,4,6,8-12".
+ *
+ * @param selectionText	The user input.
+ * @param bits			The bitset to set the selected values in.
+ * @return	True if all sections were valid numbers or ranges within the domain.
+ */
+bool LogRecordFilter::ParseRanges(const String& selectionText, SelectionBits& bits)
+{
+	StringArray sections;
+	sections.addTokens(selectionText, ",; ", "");
+	sections.removeEmptyStrings();
+
+	for (auto const& section : sections)
+	{
+		StringArray numbers;
+		numbers.addTokens(section, "-", "");
+		if (numbers.size() < 1 || numbers.size() > 2 || !numbers[0].containsOnly("0123456789") || !numbers[numbers.size() - 1].containsOnly("0123456789"))
+			return false;
+
+		auto startVal = numbers[0].getIntValue();
+		auto stopVal = numbers[numbers.size() - 1].getIntValue();
+		if (startVal > stopVal || stopVal >= FC_DomainSize)
+			return false;
+
+		for (auto i = startVal; i <= stopVal; ++i)
+			bits.set(static_cast<size_t>(i));
+	}
+
+	return bits.any();
+}
+
+/**
+ * Helper method to parse object input. Objects are given by short description
+ * (case insensitive) or numeric id, separated by ',' or ';'.
+ *
+ * @param selectionText	The user input.
+ * @param bits			The bitset to set the selected object ids in.
+ * @return	True if all entries could be resolved to an object id.
+ */
+bool LogRecordFilter::ParseObjects(const String& selectionText, SelectionBits& bits)
+{
+	StringArray objectNames;
+	objectNames.addTokens(selectionText, ",;", "");
+	objectNames.trim();
+	objectNames.removeEmptyStrings();
+
+	for (auto const& objectName : objectNames)
+	{
+		if (objectName.containsOnly("0123456789"))
+		{
+			auto objectId = objectName.getIntValue();
+			if (objectId >= FC_DomainSize)
+				return false;
+			bits.set(static_cast<size_t>(objectId));
+			continue;
+		}
+
+		auto found = false;
+		for (int i = 0; i < ROI_BridgingMAX && i < FC_DomainSize; ++i)
+		{
+			auto objectId = static_cast<RemoteObjectIdentifier>(i);
+			if (objectId != ROI_Invalid && ProcessingEngineConfig::GetObjectShortDescription(objectId).equalsIgnoreCase(objectName))
+			{
+				bits.set(static_cast<size_t>(i));
+				found = true;
+			}
+		}
+		if (!found)
+			return false;
+	}
+
+	return bits.any();
+}
@@ -0,0 +1,128 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "RemoteProtocolBridgeCommon.h"
+
+
+/**
+ * Class LogRecordFilter decides which messages are taken into logging at all.
+ * The user selection is compiled into one bitset per filtered dimension, so checking a message
+ * from an engine thread is a few atomic loads and bit tests, without locking or allocation.
+ * The bitsets are updated in place from the message thread.
+ */
+class LogRecordFilter
+{
+public:
+	enum FilterDimension
+	{
+		FD_Node = 0,	/**< Filter on the NodeId of a message. */
+		FD_Protocol,	/**< Filter on the ProtocolId a message was received on. */
+		FD_Object,		/**< Filter on the RemoteObjectIdentifier of a message. */
+		FD_Channel,		/**< Filter on the channel addressing value of a message. */
+		FD_Record,		/**< Filter on the record addressing value of a message. */
+		FD_MAX
+	};
+
+	enum FilterConstants
+	{
+		FC_DomainSize	= 4096,				/**< Number of ids per dimension that can be selected (0..FC_DomainSize-1). */
+		FC_WordCount	= FC_DomainSize / 64,	/**< Number of 64bit words per dimension bitset. */
+	};
+
+public:
+	LogRecordFilter();
+	~LogRecordFilter();
+
+	//==============================================================================
+	bool SetFilter(FilterDimension dimension, const String& selectionText);
+	void Clear();
+	bool IsActive() const;
+
+	//==============================================================================
+	/**
+	 * Method to check if a message passes the filter. This is called on engine threads for every message.
+	 *
+	 * @param NId		The node id of the message.
+	 * @param PId		The protocol id of the message.
+	 * @param Id		The remote object id of the message.
+	 * @param channel	The channel addressing value of the message.
+	 * @param record	The record addressing value of the message.
+	 * @return	True if the message is to be logged.
+	 */
+	bool Matches(NodeId NId, ProtocolId PId, RemoteObjectIdentifier Id, ChannelId channel, RecordId record) const
+	{
+		auto activeDimensions = m_activeDimensions.load(std::memory_order_relaxed);
+		if (activeDimensions == 0)
+			return true;
+
+		return Test(activeDimensions, FD_Node, static_cast<int>(NId))
+			&& Test(activeDimensions, FD_Protocol, static_cast<int>(PId))
+			&& Test(activeDimensions, FD_Object, static_cast<int>(Id))
+			&& Test(activeDimensions, FD_Channel, static_cast<int>(channel))
+			&& Test(activeDimensions, FD_Record, static_cast<int>(record));
+	};
+
+private:
+	typedef std::bitset<FC_DomainSize> SelectionBits;
+
+	static bool ParseRanges(const String& selectionText, SelectionBits& bits);
+	static bool ParseObjects(const String& selectionText, SelectionBits& bits);
+
+	/**
+	 * Helper to test a single value against the bitset of a dimension.
+	 * Values outside the selectable domain only pass dimensions that are not filtered.
+	 */
+	bool Test(uint32 activeDimensions, FilterDimension dimension, int value) const
+	{
+		if ((activeDimensions & (1u << dimension)) == 0)
+			return true;
+		if (value < 0 || value >= FC_DomainSize)
+			return false;
+
+		auto word = m_bits[dimension][value >> 6].load(std::memory_order_relaxed);
+		return (word & (uint64(1) << (value & 63))) != 0;
+	};
+
+	void Store(FilterDimension dimension, const SelectionBits& bits, bool active);
+
+private:
+	std::array<std::atomic<uint64>, FC_WordCount>	m_bits[FD_MAX];		/**< Selected ids per dimension. */
+	std::atomic<uint32>								m_activeDimensions;	/**< Bitmask of the dimensions a selection is applied on. */
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LogRecordFilter)
+};
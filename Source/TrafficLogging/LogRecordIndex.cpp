@@ -0,0 +1,314 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#include "LogRecordIndex.h"
+
+#include "LogRecordStore.h"
+
+#include "ProcessingEngine/ProcessingEngineConfig.h"
+
+
+// **************************************************************************************
+//    class LogRecordIndex
+// **************************************************************************************
+/**
+ * Constructor
+ */
+LogRecordIndex::LogRecordIndex()
+{
+	m_entryCount = 0;
+}
+
+/**
+ * Destructor
+ */
+LogRecordIndex::~LogRecordIndex()
+{
+}
+
+/**
+ * Method to take a record that was added to the store into the index.
+ * Records must be added in order of their absolute index.
+ *
+ * @param record		The record that was added.
+ * @param absoluteIndex	The absolute store index of the record.
+ */
+void LogRecordIndex::Add(const LogRecord& record, uint64 absoluteIndex)
+{
+	auto key = Key(static_cast<int>(record._objectId), static_cast<int>(record._channel), static_cast<int>(record._record), static_cast<int>(record._nodeId));
+	m_postings[key].push_back(absoluteIndex);
+	m_entryCount++;
+}
+
+/**
+ * Method to drop the entries of records that were evicted from the store.
+ * Since records are evicted oldest first, only the front of every posting list is inspected.
+ *
+ * @param beginIndex	The absolute index of the oldest record still held in the store.
+ */
+void LogRecordIndex::Prune(uint64 beginIndex)
+{
+	for (auto postingIter = m_postings.begin(); postingIter != m_postings.end();)
+	{
+		auto& postings = postingIter->second;
+		while (!postings.empty() && postings.front() < beginIndex)
+		{
+			postings.pop_front();
+			m_entryCount--;
+		}
+
+		if (postings.empty())
+			postingIter = m_postings.erase(postingIter);
+		else
+			++postingIter;
+	}
+}
+
+/**
+ * Method to remove all entries from the index.
+ */
+void LogRecordIndex::Clear()
+{
+	m_postings.clear();
+	m_entryCount = 0;
+}
+
+/**
+ * Method to find the newest record matching the query that is older than the given position.
+ *
+ * @param store			The store the index refers to.
+ * @param query			The search criteria.
+ * @param beforeIndex	The absolute index to search before, use the store end index to search from the newest record.
+ * @param foundIndex	The absolute index of the match, if one was found.
+ * @return	True if a match was found.
+ */
+bool LogRecordIndex::FindPrevious(const LogRecordStore& store, const Query& query, uint64 beforeIndex, uint64& foundIndex) const
+{
+	if (query._minAgeSeconds > 0.0)
+		beforeIndex = jmin(beforeIndex, store.FindFirstIndexAtOrAfter(Time::getMillisecondCounterHiRes() - query._minAgeSeconds * 1000.0));
+
+	auto beginIndex = store.GetBeginIndex();
+	if (beforeIndex <= beginIndex)
+		return false;
+
+	if (!query.HasKeyCriteria())
+	{
+		foundIndex = jmin(beforeIndex, store.GetEndIndex()) - 1;
+		return foundIndex >= beginIndex;
+	}
+
+	auto found = false;
+	std::map<Key, std::deque<uint64>>::const_iterator rangeBegin, rangeEnd;
+	GetKeyRange(query, rangeBegin, rangeEnd);
+	for (auto postingIter = rangeBegin; postingIter != rangeEnd; ++postingIter)
+	{
+		if (!KeyMatches(postingIter->first, query))
+			continue;
+
+		auto const& postings = postingIter->second;
+		auto upper = std::lower_bound(postings.begin(), postings.end(), beforeIndex);
+		if (upper == postings.begin())
+			continue;
+
+		auto candidate = *(upper - 1);
+		if (candidate >= beginIndex && (!found || candidate > foundIndex))
+		{
+			foundIndex = candidate;
+			found = true;
+		}
+	}
+
+	return found;
+}
+
+/**
+ * Method to find the oldest record matching the query at or after the given position.
+ *
+ * @param store			The store the index refers to.
+ * @param query			The search criteria.
+ * @param fromIndex		The absolute index to start searching at, use the store begin index to search from the oldest record.
+ * @param foundIndex	The absolute index of the match, if one was found.
+ * @return	True if a match was found.
+ */
+bool LogRecordIndex::FindNext(const LogRecordStore& store, const Query& query, uint64 fromIndex, uint64& foundIndex) const
+{
+	auto lowerIndex = jmax(fromIndex, store.GetBeginIndex());
+	auto endIndex = store.GetEndIndex();
+	if (query._minAgeSeconds > 0.0)
+		endIndex = jmin(endIndex, store.FindFirstIndexAtOrAfter(Time::getMillisecondCounterHiRes() - query._minAgeSeconds * 1000.0));
+
+	if (lowerIndex >= endIndex)
+		return false;
+
+	if (!query.HasKeyCriteria())
+	{
+		foundIndex = lowerIndex;
+		return true;
+	}
+
+	auto found = false;
+	std::map<Key, std::deque<uint64>>::const_iterator rangeBegin, rangeEnd;
+	GetKeyRange(query, rangeBegin, rangeEnd);
+	for (auto postingIter = rangeBegin; postingIter != rangeEnd; ++postingIter)
+	{
+		if (!KeyMatches(postingIter->first, query))
+			continue;
+
+		auto const& postings = postingIter->second;
+		auto lower = std::lower_bound(postings.begin(), postings.end(), lowerIndex);
+		if (lower == postings.end())
+			continue;
+
+		auto candidate = *lower;
+		if (candidate < endIndex && (!found || candidate < foundIndex))
+		{
+			foundIndex = candidate;
+			found = true;
+		}
+	}
+
+	return found;
+}
+
+/**
+ * Getter for the number of distinct (object, channel, record, node) combinations in the index.
+ *
+ * @return	The key count.
+ */
+int LogRecordIndex::GetKeyCount() const
+{
+	return static_cast<int>(m_postings.size());
+}
+
+/**
+ * Getter for an estimate of the memory the index uses, with the postings and a fixed overhead per key.
+ *
+ * @return	The memory in bytes.
+ */
+int64 LogRecordIndex::GetMemoryBytes() const
+{
+	return int64(m_entryCount) * IC_BytesPerEntry + int64(m_postings.size()) * IC_BytesPerKey;
+}
+
+/**
+ * Method to parse search box input into a query. The input is a list of 'field=value' terms
+ * separated by ',' or ';', e.g. "node=2, obj=Sound Object Position XY, ch=17".
+ * Fields are node, obj (short description or numeric id), ch, rec and age (min. age in seconds).
+ *
+ * @param queryText	The user input.
+ * @param query		The query to fill.
+ * @return	True if all terms could be parsed and at least one criterion is given.
+ */
+bool LogRecordIndex::ParseQuery(const String& queryText, Query& query)
+{
+	query = Query();
+
+	StringArray terms;
+	terms.addTokens(queryText, ",;", "");
+	terms.trim();
+	terms.removeEmptyStrings();
+	if (terms.isEmpty())
+		return false;
+
+	for (auto const& term : terms)
+	{
+		auto field = term.upToFirstOccurrenceOf("=", false, false).trim().toLowerCase();
+		auto value = term.fromFirstOccurrenceOf("=", false, false).trim();
+		if (field.isEmpty() || value.isEmpty() || !term.contains("="))
+			return false;
+
+		auto isNumber = value.containsOnly("0123456789");
+		if (field == "node" && isNumber)
+			query._nodeId = value.getIntValue();
+		else if (field == "ch" && isNumber)
+			query._channel = value.getIntValue();
+		else if (field == "rec" && isNumber)
+			query._record = value.getIntValue();
+		else if (field == "age" && value.containsOnly("0123456789."))
+			query._minAgeSeconds = value.getDoubleValue();
+		else if (field == "obj" && isNumber)
+			query._objectId = value.getIntValue();
+		else if (field == "obj")
+		{
+			for (int i = ROI_Invalid + 1; i < ROI_BridgingMAX; ++i)
+				if (ProcessingEngineConfig::GetObjectShortDescription(static_cast<RemoteObjectIdentifier>(i)).equalsIgnoreCase(value))
+					query._objectId = i;
+
+			if (query._objectId == IC_AnyValue)
+				return false;
+		}
+		else
+			return false;
+	}
+
+	return true;
+}
+
+/**
+ * Helper method to check if a key fulfills the key criteria of a query.
+ *
+ * @param key	The key to check.
+ * @param query	The search criteria.
+ * @return	True if the key matches.
+ */
+bool LogRecordIndex::KeyMatches(const Key& key, const Query& query) const
+{
+	return (query._objectId == IC_AnyValue || std::get<0>(key) == query._objectId)
+		&& (query._channel == IC_AnyValue || std::get<1>(key) == query._channel)
+		&& (query._record == IC_AnyValue || std::get<2>(key) == query._record)
+		&& (query._nodeId == IC_AnyValue || std::get<3>(key) == query._nodeId);
+}
+
+/**
+ * Helper method to narrow the keys that need to be inspected for a query. Keys are ordered by
+ * object first, so a query for an object only visits the keys of that object. There is no secondary
+ * ordering by node, channel or record, so a query without an object visits every key.
+ *
+ * @param query	The search criteria.
+ * @param begin	The first key to inspect.
+ * @param end	The key after the last one to inspect.
+ */
+void LogRecordIndex::GetKeyRange(const Query& query, std::map<Key, std::deque<uint64>>::const_iterator& begin, std::map<Key, std::deque<uint64>>::const_iterator& end) const
+{
+	if (query._objectId == IC_AnyValue)
+	{
+		begin = m_postings.begin();
+		end = m_postings.end();
+		return;
+	}
+
+	auto lowest = std::numeric_limits<int>::min();
+	begin = m_postings.lower_bound(Key(query._objectId, lowest, lowest, lowest));
+	end = m_postings.lower_bound(Key(query._objectId + 1, lowest, lowest, lowest));
+}
@@ -0,0 +1,115 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <deque>
+
+#include "LogRecord.h"
+
+// Fwd. Declarations
+class LogRecordStore;
+
+
+/**
+ * Class LogRecordIndex is an incremental search index over the records of a LogRecordStore.
+ * For every (object, channel, record, node) combination the absolute store indices of its records
+ * are kept in ascending order, so the previous or next match of a query relative to a position is
+ * found with a binary search per combination instead of scanning the history. Time bounds are
+ * resolved against the store itself, whose records are held in order of reception.
+ * Keys are ordered by object first, so only queries with an object criterion are narrowed to a key range.
+ * Queries on node, channel or record alone walk all keys, which is linear in the number of combinations.
+ * The index is not thread safe and is meant to be used from the message thread only.
+ */
+class LogRecordIndex
+{
+public:
+	enum IndexConstants
+	{
+		IC_AnyValue			= -1,				/**< Query value that matches all values of a field. */
+		IC_BytesPerEntry	= sizeof(uint64),	/**< Memory a posting takes per indexed record. */
+		IC_BytesPerKey		= 640,				/**< Approximate memory per key, for its map node and the first block of its posting list. */
+	};
+
+	/**
+	 * Search criteria. Fields set to IC_AnyValue are not evaluated.
+	 */
+	struct Query
+	{
+		int		_nodeId{ IC_AnyValue };		/**< Node the record was received in. */
+		int		_objectId{ IC_AnyValue };	/**< Remote object of the record. */
+		int		_channel{ IC_AnyValue };	/**< Channel addressing value of the record. */
+		int		_record{ IC_AnyValue };		/**< Record addressing value of the record. */
+		double	_minAgeSeconds{ 0.0 };		/**< Only records at least this old match. */
+
+		bool HasKeyCriteria() const
+		{
+			return _nodeId != IC_AnyValue || _objectId != IC_AnyValue || _channel != IC_AnyValue || _record != IC_AnyValue;
+		};
+	};
+
+public:
+	LogRecordIndex();
+	~LogRecordIndex();
+
+	//==============================================================================
+	void Add(const LogRecord& record, uint64 absoluteIndex);
+	void Prune(uint64 beginIndex);
+	void Clear();
+
+	//==============================================================================
+	bool FindPrevious(const LogRecordStore& store, const Query& query, uint64 beforeIndex, uint64& foundIndex) const;
+	bool FindNext(const LogRecordStore& store, const Query& query, uint64 fromIndex, uint64& foundIndex) const;
+
+	//==============================================================================
+	int GetKeyCount() const;
+	int64 GetMemoryBytes() const;
+
+	//==============================================================================
+	static bool ParseQuery(const String& queryText, Query& query);
+
+private:
+	typedef std::tuple<int, int, int, int> Key;	/**< Object, channel, record and node of a record, in this order. */
+
+	bool KeyMatches(const Key& key, const Query& query) const;
+	void GetKeyRange(const Query& query, std::map<Key, std::deque<uint64>>::const_iterator& begin, std::map<Key, std::deque<uint64>>::const_iterator& end) const;
+
+private:
+	std::map<Key, std::deque<uint64>>	m_postings;		/**< Ascending absolute store indices per key. */
+	uint64								m_entryCount;	/**< Count of postings over all keys. */
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LogRecordIndex)
+};
@@ -0,0 +1,144 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#include "LogRecordRing.h"
+
+
+// **************************************************************************************
+//    class LogRecordRing
+// **************************************************************************************
+/**
+ * Constructor. The complete storage is allocated here, no allocation happens afterwards.
+ *
+ * @param capacity	The requested number of records the ring can hold. This is rounded up to the next power of two.
+ */
+LogRecordRing::LogRecordRing(int capacity)
+{
+	auto powerOfTwoCapacity = static_cast<size_t>(nextPowerOfTwo(jmax(2, capacity)));
+
+	m_cells = std::make_unique<Cell[]>(powerOfTwoCapacity);
+	m_mask = powerOfTwoCapacity - 1;
+
+	for (size_t i = 0; i < powerOfTwoCapacity; ++i)
+		m_cells[i]._sequence.store(i, std::memory_order_relaxed);
+}
+
+/**
+ * Destructor
+ */
+LogRecordRing::~LogRecordRing()
+{
+}
+
+/**
+ * Method to push a record into the ring. This may be called from any thread concurrently.
+ * If the ring is full, the record is dropped and the drop counter is increased.
+ *
+ * @param record	The record to copy into the ring.
+ * @return	True if the record was queued, false if it was dropped.
+ */
+bool LogRecordRing::Push(const LogRecord& record)
+{
+	auto pos = m_enqueuePos.load(std::memory_order_relaxed);
+	for (;;)
+	{
+		auto& cell = m_cells[pos & m_mask];
+		auto seq = cell._sequence.load(std::memory_order_acquire);
+		auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+		if (diff == 0)
+		{
+			// the cell is free, try to claim it
+			if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+			{
+				cell._record = record;
+				cell._sequence.store(pos + 1, std::memory_order_release);
+				return true;
+			}
+		}
+		else if (diff < 0)
+		{
+			// the cell still holds a record from the previous lap, the ring is full
+			m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		else
+		{
+			// another producer claimed the cell in the meantime
+			pos = m_enqueuePos.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+/**
+ * Method to pop the oldest record from the ring. Only one thread must consume from the ring.
+ *
+ * @param record	The record object to copy the popped record data into.
+ * @return	True if a record was popped, false if the ring was empty.
+ */
+bool LogRecordRing::Pop(LogRecord& record)
+{
+	auto pos = m_dequeuePos.load(std::memory_order_relaxed);
+	auto& cell = m_cells[pos & m_mask];
+	auto seq = cell._sequence.load(std::memory_order_acquire);
+	auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+	if (diff < 0)
+		return false;
+
+	record = cell._record;
+	cell._sequence.store(pos + m_mask + 1, std::memory_order_release);
+	m_dequeuePos.store(pos + 1, std::memory_order_relaxed);
+
+	return true;
+}
+
+/**
+ * Getter for the number of records the ring can hold.
+ *
+ * @return	The ring capacity.
+ */
+int LogRecordRing::GetCapacity() const
+{
+	return static_cast<int>(m_mask + 1);
+}
+
+/**
+ * Getter for the number of records that were dropped since creation of the ring
+ * because it was full at the time of pushing.
+ *
+ * @return	The overall count of dropped records.
+ */
+uint64 LogRecordRing::GetDroppedCount() const
+{
+	return m_droppedCount.load(std::memory_order_relaxed);
+}
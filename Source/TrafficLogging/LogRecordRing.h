@@ -0,0 +1,81 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "LogRecord.h"
+
+
+/**
+ * Class LogRecordRing is a preallocated, bounded and lock-free queue of LogRecord entries.
+ * Any number of engine threads may push records concurrently, while a single consumer
+ * (usually the message thread) pops them. When the ring is full, records are not queued
+ * but counted as dropped, so pushing never blocks and never allocates.
+ */
+class LogRecordRing
+{
+public:
+	LogRecordRing(int capacity);
+	~LogRecordRing();
+
+	//==============================================================================
+	bool Push(const LogRecord& record);
+	bool Pop(LogRecord& record);
+
+	//==============================================================================
+	int GetCapacity() const;
+	uint64 GetDroppedCount() const;
+
+private:
+	/**
+	 * Single storage cell of the ring. The sequence number tells producers and consumer
+	 * if the cell is free to be written or holds a record ready to be read.
+	 */
+	struct Cell
+	{
+		std::atomic<size_t>	_sequence{ 0 };	/**< Sequence number of the cell, used to hand over ownership between producers and consumer. */
+		LogRecord			_record;		/**< The record data of the cell. */
+	};
+
+	std::unique_ptr<Cell[]>		m_cells;			/**< Preallocated cell storage. */
+	size_t						m_mask;				/**< Index mask, capacity is always a power of two. */
+
+	alignas(64) std::atomic<size_t>	m_enqueuePos{ 0 };	/**< Next position producers write to. Kept on its own cache line to avoid false sharing. */
+	alignas(64) std::atomic<size_t>	m_dequeuePos{ 0 };	/**< Next position the consumer reads from. */
+	alignas(64) std::atomic<uint64>	m_droppedCount{ 0 };/**< Count of records that could not be pushed because the ring was full. */
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LogRecordRing)
+};
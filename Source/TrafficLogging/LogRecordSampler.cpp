@@ -0,0 +1,187 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#include "LogRecordSampler.h"
+
+
+// **************************************************************************************
+//    class LogRecordSampler
+// **************************************************************************************
+/**
+ * Constructor. Initially all messages are accepted.
+ */
+LogRecordSampler::LogRecordSampler()
+	: m_rateSlots(new std::atomic<uint64>[SC_RateSlotCount]),
+	m_minSpacingMs(0),
+	m_sampleInterval(1),
+	m_sampleCounter(0),
+	m_offeredCount(0),
+	m_acceptedCount(0),
+	m_automatic(false),
+	m_budgetPercent(100.0)
+{
+	for (int i = 0; i < SC_RateSlotCount; ++i)
+		m_rateSlots[i].store(0, std::memory_order_relaxed);
+}
+
+/**
+ * Destructor
+ */
+LogRecordSampler::~LogRecordSampler()
+{
+}
+
+/**
+ * Method to set a fixed 1-in-N sampling. This leaves the automatic mode.
+ *
+ * @param interval	The N of 1-in-N sampling, 1 to accept all messages.
+ */
+void LogRecordSampler::SetSampleInterval(int interval)
+{
+	m_automatic = false;
+	m_sampleInterval.store(static_cast<uint32>(jlimit(1, int(SC_MaxSampleInterval), interval)), std::memory_order_relaxed);
+}
+
+/**
+ * Getter for the current N of 1-in-N sampling. In automatic mode this is the last adjusted value.
+ *
+ * @return	The sample interval, 1 if all messages are accepted.
+ */
+int LogRecordSampler::GetSampleInterval() const
+{
+	return static_cast<int>(m_sampleInterval.load(std::memory_order_relaxed));
+}
+
+/**
+ * Method to enable or disable the automatic mode. When enabled, sampling starts with all messages accepted
+ * and is lowered by ::AdjustToLoad as soon as the ingest exceeds the budget.
+ *
+ * @param automatic		True to adjust the sampling to the ingest load.
+ * @param budgetPercent	Share of the flush period in percent the ingest may take.
+ */
+void LogRecordSampler::SetAutomatic(bool automatic, double budgetPercent)
+{
+	m_budgetPercent = jlimit(1.0, 100.0, budgetPercent);
+	if (m_automatic == automatic)
+		return;
+
+	m_automatic = automatic;
+	m_sampleInterval.store(1, std::memory_order_relaxed);
+}
+
+/**
+ * Getter for the automatic mode.
+ *
+ * @return	True if the sampling follows the ingest load.
+ */
+bool LogRecordSampler::IsAutomatic() const
+{
+	return m_automatic;
+}
+
+/**
+ * Method to set the max. number of messages per second that are accepted per (object, channel).
+ * Messages of an object that follow the last accepted one too closely are not accepted.
+ *
+ * @param maxRateHz	The max. rate, 0 for no limit.
+ */
+void LogRecordSampler::SetMaxObjectRate(int maxRateHz)
+{
+	auto minSpacingMs = 0u;
+	if (maxRateHz > 0)
+		minSpacingMs = static_cast<uint32>(1000 / jmin(maxRateHz, int(SC_MaxRateHz)));
+
+	m_minSpacingMs.store(minSpacingMs, std::memory_order_relaxed);
+}
+
+/**
+ * Method to adjust the sample interval to the measured ingest load. This is called on the message thread
+ * once per flush period and does nothing outside of automatic mode.
+ * The interval is doubled while the ingest exceeds the budget, and only halved again when the ingest
+ * takes less than a quarter of the budget, so the sampling does not toggle between two steps.
+ *
+ * @param ingestMs	Time in ms the last ingest of queued records took.
+ * @param periodMs	Time in ms since the previous ingest.
+ */
+void LogRecordSampler::AdjustToLoad(double ingestMs, double periodMs)
+{
+	if (!m_automatic || periodMs <= 0.0)
+		return;
+
+	auto loadPercent = 100.0 * ingestMs / periodMs;
+	auto interval = m_sampleInterval.load(std::memory_order_relaxed);
+	if (loadPercent > m_budgetPercent)
+		interval = jmin(interval * 2, static_cast<uint32>(SC_MaxSampleInterval));
+	else if (loadPercent < 0.25 * m_budgetPercent)
+		interval = jmax(interval / 2, 1u);
+
+	m_sampleInterval.store(interval, std::memory_order_relaxed);
+}
+
+/**
+ * Method to take the counts of checked and accepted messages since the counts were last taken.
+ *
+ * @param offeredCount	The count of messages that were checked.
+ * @param acceptedCount	The count of messages that were accepted.
+ */
+void LogRecordSampler::TakeCounts(uint64& offeredCount, uint64& acceptedCount)
+{
+	acceptedCount = m_acceptedCount.exchange(0, std::memory_order_relaxed);
+	offeredCount = m_offeredCount.exchange(0, std::memory_order_relaxed);
+}
+
+/**
+ * Helper method to check and update the rate limiting slot of an (object, channel) combination.
+ * Combinations that share a slot replace each other, which at worst lets a message more pass.
+ *
+ * @param Id			The remote object id of the message.
+ * @param channel		The channel addressing value of the message.
+ * @param nowMs			The current time in ms.
+ * @param minSpacingMs	Min. time between two accepted messages of the combination.
+ * @return	True if the message is within the max. rate of its combination.
+ */
+bool LogRecordSampler::TakeRateSlot(RemoteObjectIdentifier Id, ChannelId channel, uint32 nowMs, uint32 minSpacingMs)
+{
+	auto key = (static_cast<uint32>(Id) << 16) | (static_cast<uint32>(channel) & 0xffff);
+	auto& slot = m_rateSlots[(key * 0x9E3779B1u) >> (32 - SC_RateSlotBits)];
+
+	auto current = slot.load(std::memory_order_relaxed);
+	auto lastMs = static_cast<uint32>(current);
+	if (current != 0 && static_cast<uint32>(current >> 32) == key && (nowMs - lastMs) < minSpacingMs)
+		return false;
+
+	// if another thread accepted a message for the slot in between, this one is within its spacing
+	auto desired = (static_cast<uint64>(key) << 32) | nowMs;
+	return slot.compare_exchange_strong(current, desired, std::memory_order_relaxed);
+}
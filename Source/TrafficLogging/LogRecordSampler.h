@@ -0,0 +1,118 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "RemoteProtocolBridgeCommon.h"
+
+
+/**
+ * Class LogRecordSampler thins out the messages that are taken into logging when the traffic is too high to follow.
+ * It combines a max. update rate per (object, channel) with 1-in-N sampling of the remaining messages.
+ * In automatic mode, N is adjusted from the message thread to keep the ui ingest time within a cpu budget.
+ * Checking a message from an engine thread only uses atomics, without locking or allocation.
+ */
+class LogRecordSampler
+{
+public:
+	enum SamplerConstants
+	{
+		SC_RateSlotBits			= 12,						/**< Number of hash bits used to address the rate limiting slots. */
+		SC_RateSlotCount		= 1 << SC_RateSlotBits,		/**< Number of (object, channel) combinations the rate is tracked for at the same time. */
+		SC_MaxRateHz			= 1000,						/**< Highest per object rate that can be set, limited by the ms resolution of the slots. */
+		SC_MaxSampleInterval	= 1024,						/**< Highest N the automatic mode lowers the sampling rate to. */
+	};
+
+public:
+	LogRecordSampler();
+	~LogRecordSampler();
+
+	//==============================================================================
+	void SetSampleInterval(int interval);
+	int GetSampleInterval() const;
+	void SetAutomatic(bool automatic, double budgetPercent);
+	bool IsAutomatic() const;
+	void SetMaxObjectRate(int maxRateHz);
+
+	//==============================================================================
+	void AdjustToLoad(double ingestMs, double periodMs);
+	void TakeCounts(uint64& offeredCount, uint64& acceptedCount);
+
+	//==============================================================================
+	/**
+	 * Method to check if a message is taken into logging. This is called on engine threads for every message
+	 * that passed the filter. The per object rate is checked first, so a single hot object does not cost
+	 * the other objects their share of the sampled messages.
+	 *
+	 * @param Id		The remote object id of the message.
+	 * @param channel	The channel addressing value of the message.
+	 * @param nowMs		The current time in ms, as delivered by Time::getMillisecondCounter.
+	 * @return	True if the message is to be logged.
+	 */
+	bool Accept(RemoteObjectIdentifier Id, ChannelId channel, uint32 nowMs)
+	{
+		m_offeredCount.fetch_add(1, std::memory_order_relaxed);
+
+		auto minSpacingMs = m_minSpacingMs.load(std::memory_order_relaxed);
+		if (minSpacingMs > 0 && !TakeRateSlot(Id, channel, nowMs, minSpacingMs))
+			return false;
+
+		auto interval = m_sampleInterval.load(std::memory_order_relaxed);
+		if (interval > 1 && (m_sampleCounter.fetch_add(1, std::memory_order_relaxed) % interval) != 0)
+			return false;
+
+		m_acceptedCount.fetch_add(1, std::memory_order_relaxed);
+		return true;
+	};
+
+private:
+	bool TakeRateSlot(RemoteObjectIdentifier Id, ChannelId channel, uint32 nowMs, uint32 minSpacingMs);
+
+private:
+	std::unique_ptr<std::atomic<uint64>[]>	m_rateSlots;		/**< Per slot the (object, channel) key in the upper and the last accepted time in ms in the lower 32 bits. */
+	std::atomic<uint32>						m_minSpacingMs;		/**< Min. time between two accepted messages of the same (object, channel), 0 for no limit. */
+
+	std::atomic<uint32>						m_sampleInterval;	/**< Every N-th message is accepted, 1 to accept all. */
+	std::atomic<uint32>						m_sampleCounter;	/**< Running count of messages that were subject to sampling. */
+
+	std::atomic<uint64>						m_offeredCount;		/**< Count of messages checked since counts were last taken. */
+	std::atomic<uint64>						m_acceptedCount;	/**< Count of messages accepted since counts were last taken. */
+
+	bool									m_automatic;		/**< Flag to indicate that the sample interval follows the ingest load. Only used on message thread. */
+	double									m_budgetPercent;	/**< Share of the flush period the ingest may take in automatic mode. Only used on message thread. */
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LogRecordSampler)
+};
@@ -0,0 +1,287 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#include "LogRecordStore.h"
+
+#include "TrafficLoggingConfig.h"
+
+#include <limits>
+
+
+// **************************************************************************************
+//    class LogRecordStore
+// **************************************************************************************
+/**
+ * Constructor. The store is initialized with the default retention policy.
+ */
+LogRecordStore::LogRecordStore()
+{
+	m_capacity = 1;
+	m_head = 0;
+	m_count = 0;
+	m_beginIndex = 0;
+	m_evictedCount = 0;
+
+	RetentionPolicy defaultPolicy;
+	defaultPolicy._maxRecordCount = TLD_MaxRecords;
+	defaultPolicy._maxMemoryBytes = int64(TLD_MaxMemoryMB) * 1024 * 1024;
+	defaultPolicy._maxAgeMs = double(TLD_MaxAgeSeconds) * 1000.0;
+	SetRetentionPolicy(defaultPolicy);
+}
+
+/**
+ * Destructor
+ */
+LogRecordStore::~LogRecordStore()
+{
+}
+
+/**
+ * Setter for the retention policy. If the new limits are lower than the current
+ * contents, the oldest records are evicted and the unused memory is released.
+ *
+ * @param policy	The new retention policy to apply.
+ */
+void LogRecordStore::SetRetentionPolicy(const RetentionPolicy& policy)
+{
+	m_policy = policy;
+
+	auto capacity = std::numeric_limits<int>::max();
+	if (m_policy._maxRecordCount > 0)
+		capacity = jmin(capacity, m_policy._maxRecordCount);
+	if (m_policy._maxMemoryBytes > 0)
+		capacity = static_cast<int>(jmin(int64(capacity), m_policy._maxMemoryBytes / (int64(sizeof(LogRecord)) + jmax(0, m_policy._indexBytesPerRecord))));
+	m_capacity = jmax(1, capacity);
+
+	if (m_count > static_cast<size_t>(m_capacity) || m_records.size() > static_cast<size_t>(m_capacity))
+	{
+		while (m_count > static_cast<size_t>(m_capacity))
+			EvictOldest();
+
+		Linearize();
+		m_records.resize(m_count);
+		m_records.shrink_to_fit();
+	}
+}
+
+/**
+ * Getter for the currently applied retention policy.
+ *
+ * @return	The retention policy.
+ */
+const LogRecordStore::RetentionPolicy& LogRecordStore::GetRetentionPolicy() const
+{
+	return m_policy;
+}
+
+/**
+ * Method to append a record to the store. If the store is at its capacity,
+ * the oldest record is evicted to make room for the new one.
+ *
+ * @param record	The record to append.
+ */
+void LogRecordStore::Add(const LogRecord& record)
+{
+	if (m_count == static_cast<size_t>(m_capacity))
+		EvictOldest();
+
+	if (m_count == m_records.size())
+	{
+		// all allocated slots are in use, but capacity is not yet reached, so grow the buffer
+		// without letting the vector allocate beyond the capacity the policy allows for
+		Linearize();
+		if (m_records.size() == m_records.capacity())
+			m_records.reserve(jmin(jmax(size_t(1024), m_records.capacity() * 2), static_cast<size_t>(m_capacity)));
+		m_records.push_back(record);
+	}
+	else
+	{
+		m_records[(m_head + m_count) % m_records.size()] = record;
+	}
+
+	m_count++;
+}
+
+/**
+ * Method to evict all records that are older than the max. age of the retention policy.
+ * Since records are held in order of reception, this only inspects the oldest records.
+ *
+ * @param now	The current time in ms, as delivered by Time::getMillisecondCounterHiRes.
+ */
+void LogRecordStore::EvictExpired(double now)
+{
+	if (m_policy._maxAgeMs <= 0.0)
+		return;
+
+	auto oldestAllowed = now - m_policy._maxAgeMs;
+	while (m_count > 0 && m_records[m_head]._timestamp < oldestAllowed)
+		EvictOldest();
+}
+
+/**
+ * Method to remove all records from the store. Absolute indices keep counting on,
+ * so indices that were handed out before are not reused for new records.
+ */
+void LogRecordStore::Clear()
+{
+	m_beginIndex = GetEndIndex();
+	m_records.clear();
+	m_head = 0;
+	m_count = 0;
+}
+
+/**
+ * Helper method to drop the oldest record.
+ */
+void LogRecordStore::EvictOldest()
+{
+	if (m_count == 0)
+		return;
+
+	m_head = (m_head + 1) % m_records.size();
+	m_count--;
+	m_beginIndex++;
+	m_evictedCount++;
+}
+
+/**
+ * Helper method to reorder the circular buffer so that the oldest record is at its front.
+ */
+void LogRecordStore::Linearize()
+{
+	if (m_head == 0)
+		return;
+
+	std::rotate(m_records.begin(), m_records.begin() + m_head, m_records.end());
+	m_records.resize(m_count);
+	m_head = 0;
+}
+
+/**
+ * Getter for the absolute index of the oldest record in the store.
+ *
+ * @return	The absolute index of the oldest record.
+ */
+uint64 LogRecordStore::GetBeginIndex() const
+{
+	return m_beginIndex;
+}
+
+/**
+ * Getter for the absolute index one past the newest record in the store.
+ *
+ * @return	The absolute index the next added record will get.
+ */
+uint64 LogRecordStore::GetEndIndex() const
+{
+	return m_beginIndex + m_count;
+}
+
+/**
+ * Getter for the number of records currently held in the store.
+ *
+ * @return	The record count.
+ */
+int LogRecordStore::GetSize() const
+{
+	return static_cast<int>(m_count);
+}
+
+/**
+ * Getter for the memory the store currently uses for retained records.
+ *
+ * @return	The memory in bytes.
+ */
+int64 LogRecordStore::GetRetainedBytes() const
+{
+	return int64(m_records.capacity() * sizeof(LogRecord));
+}
+
+/**
+ * Getter for the number of records that were evicted since creation of the store,
+ * due to the limits of the retention policy.
+ *
+ * @return	The count of evicted records.
+ */
+uint64 LogRecordStore::GetEvictedCount() const
+{
+	return m_evictedCount;
+}
+
+/**
+ * Helper method to check if a record with given absolute index is held in the store.
+ *
+ * @param absoluteIndex	The index to check.
+ * @return	True if the record is available.
+ */
+bool LogRecordStore::Contains(uint64 absoluteIndex) const
+{
+	return absoluteIndex >= GetBeginIndex() && absoluteIndex < GetEndIndex();
+}
+
+/**
+ * Getter for a record by its absolute index. The index must refer to a record
+ * that is contained in the store.
+ *
+ * @param absoluteIndex	The absolute index of the record to get.
+ * @return	The requested record.
+ */
+const LogRecord& LogRecordStore::Get(uint64 absoluteIndex) const
+{
+	jassert(Contains(absoluteIndex));
+	return m_records[(m_head + static_cast<size_t>(absoluteIndex - m_beginIndex)) % m_records.size()];
+}
+
+/**
+ * Method to find the oldest record that was received at or after the given time.
+ * Records are held in order of reception, so this is a binary search over the retained records.
+ *
+ * @param timestamp	The time in ms, as delivered by Time::getMillisecondCounterHiRes.
+ * @return	The absolute index of the record, or the end index if all records are older.
+ */
+uint64 LogRecordStore::FindFirstIndexAtOrAfter(double timestamp) const
+{
+	auto lower = GetBeginIndex();
+	auto upper = GetEndIndex();
+	while (lower < upper)
+	{
+		auto middle = lower + (upper - lower) / 2;
+		if (Get(middle)._timestamp < timestamp)
+			lower = middle + 1;
+		else
+			upper = middle;
+	}
+
+	return lower;
+}
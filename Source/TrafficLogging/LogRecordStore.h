@@ -0,0 +1,103 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "LogRecord.h"
+
+
+/**
+ * Class LogRecordStore holds the history of log records on the message thread.
+ * Records are addressed by an absolute index that counts all records ever added,
+ * so views can keep referring to a record independent of what was added afterwards.
+ * The store is bounded by a retention policy. Records are kept in a circular buffer,
+ * so evicting the oldest record when the limits are reached is O(1).
+ */
+class LogRecordStore
+{
+public:
+	/**
+	 * Limits the store applies to the retained records. A value of 0 disables the respective limit,
+	 * except for the count and memory limits that are always in effect with at least one record.
+	 */
+	struct RetentionPolicy
+	{
+		int		_maxRecordCount{ 0 };	/**< Max. number of records to retain. */
+		int64	_maxMemoryBytes{ 0 };	/**< Max. memory to use for retained records, including the per record memory of an index over them. */
+		int		_indexBytesPerRecord{ 0 };	/**< Memory an index over the store uses per retained record, accounted against the memory limit. */
+		double	_maxAgeMs{ 0.0 };		/**< Max. age of retained records in ms. */
+	};
+
+public:
+	LogRecordStore();
+	~LogRecordStore();
+
+	//==============================================================================
+	void SetRetentionPolicy(const RetentionPolicy& policy);
+	const RetentionPolicy& GetRetentionPolicy() const;
+
+	//==============================================================================
+	void Add(const LogRecord& record);
+	void EvictExpired(double now);
+	void Clear();
+
+	//==============================================================================
+	uint64 GetBeginIndex() const;
+	uint64 GetEndIndex() const;
+	int GetSize() const;
+	int64 GetRetainedBytes() const;
+	uint64 GetEvictedCount() const;
+	bool Contains(uint64 absoluteIndex) const;
+	const LogRecord& Get(uint64 absoluteIndex) const;
+	uint64 FindFirstIndexAtOrAfter(double timestamp) const;
+
+private:
+	void EvictOldest();
+	void Linearize();
+
+private:
+	RetentionPolicy			m_policy;		/**< The limits the store applies. */
+	int						m_capacity;		/**< Max. record count resulting from policy count and memory limits. */
+
+	std::vector<LogRecord>	m_records;		/**< Circular record buffer. Grows on demand up to m_capacity. */
+	size_t					m_head;			/**< Position of the oldest record in m_records. */
+	size_t					m_count;		/**< Number of records currently held in m_records. */
+
+	uint64					m_beginIndex;	/**< Absolute index of the oldest record held. */
+	uint64					m_evictedCount;	/**< Count of records that were evicted due to the retention policy. */
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LogRecordStore)
+};
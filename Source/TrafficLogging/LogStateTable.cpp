@@ -0,0 +1,203 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#include "LogStateTable.h"
+
+
+// **************************************************************************************
+//    class LogStateTable
+// **************************************************************************************
+/**
+ * Constructor
+ */
+LogStateTable::LogStateTable()
+	: m_overflowCount(0)
+{
+	Clear();
+}
+
+/**
+ * Destructor
+ */
+LogStateTable::~LogStateTable()
+{
+}
+
+/**
+ * Method to take a record into the table. The entry of the record's object is
+ * replaced by the record, or a new entry is appended if the object is not yet known.
+ *
+ * @param record	The record to take into the table.
+ */
+void LogStateTable::Update(const LogRecord& record)
+{
+	auto hash = HashKey(record);
+	auto slot = Find(record, hash);
+	auto entryIndex = m_slots[static_cast<size_t>(slot)];
+
+	if (entryIndex >= 0)
+	{
+		auto& entry = m_entries[static_cast<size_t>(entryIndex)];
+		entry._record = record;
+		entry._updateCount++;
+	}
+	else if (m_entries.size() >= STC_MaxEntries)
+	{
+		m_overflowCount++;
+		return;
+	}
+	else
+	{
+		Entry entry;
+		entry._record = record;
+		entry._updateCount = 1;
+		m_entries.push_back(entry);
+		m_slots[static_cast<size_t>(slot)] = static_cast<int>(m_entries.size() - 1);
+
+		// keep the load factor below 0.5 to keep probe sequences short
+		if (m_entries.size() * 2 > m_slots.size())
+			Rehash(m_slots.size() * 2);
+	}
+}
+
+/**
+ * Method to remove all entries from the table.
+ */
+void LogStateTable::Clear()
+{
+	m_entries.clear();
+	m_slots.assign(1024, -1);
+	m_overflowCount = 0;
+}
+
+/**
+ * Getter for the number of tracked objects.
+ *
+ * @return	The number of entries.
+ */
+int LogStateTable::GetSize() const
+{
+	return static_cast<int>(m_entries.size());
+}
+
+/**
+ * Getter for an entry by its row, i.e. the order of first appearance.
+ *
+ * @param row	The row of the entry. Must be in range 0..GetSize()-1.
+ * @return	The entry.
+ */
+const LogStateTable::Entry& LogStateTable::Get(int row) const
+{
+	jassert(row >= 0 && row < GetSize());
+	return m_entries[static_cast<size_t>(row)];
+}
+
+/**
+ * Getter for the number of records that could not be tracked because the table was full.
+ *
+ * @return	The overflow count.
+ */
+uint64 LogStateTable::GetOverflowCount() const
+{
+	return m_overflowCount;
+}
+
+/**
+ * Helper method to calculate the hash of the object key of a record.
+ *
+ * @param record	The record to hash the key of.
+ * @return	The hash value.
+ */
+uint64 LogStateTable::HashKey(const LogRecord& record)
+{
+	auto key = (uint64(uint32(record._nodeId)) << 32) ^ (uint64(uint32(record._protocolId)) << 16) ^ uint64(uint32(record._objectId));
+	key = key * 0x9E3779B97F4A7C15ull ^ ((uint64(uint16(record._channel)) << 16) | uint64(uint16(record._record)));
+
+	// finalizer of splitmix64, to spread the key bits over the whole hash
+	key ^= key >> 30;
+	key *= 0xBF58476D1CE4E5B9ull;
+	key ^= key >> 27;
+	key *= 0x94D049BB133111EBull;
+	key ^= key >> 31;
+
+	return key;
+}
+
+/**
+ * Helper method to compare the object keys of two records.
+ *
+ * @return	True if both records refer to the same object.
+ */
+bool LogStateTable::KeyEquals(const LogRecord& a, const LogRecord& b)
+{
+	return a._nodeId == b._nodeId
+		&& a._protocolId == b._protocolId
+		&& a._objectId == b._objectId
+		&& a._channel == b._channel
+		&& a._record == b._record;
+}
+
+/**
+ * Helper method to find the hash index slot of a record's object.
+ *
+ * @param record	The record to look up.
+ * @param hash		The hash of the record's object key.
+ * @return	The slot that refers to the object's entry, or the empty slot the object is to be inserted at.
+ */
+int LogStateTable::Find(const LogRecord& record, uint64 hash) const
+{
+	auto mask = m_slots.size() - 1;
+	for (auto slot = static_cast<size_t>(hash) & mask;; slot = (slot + 1) & mask)
+	{
+		auto entryIndex = m_slots[slot];
+		if (entryIndex < 0 || KeyEquals(m_entries[static_cast<size_t>(entryIndex)]._record, record))
+			return static_cast<int>(slot);
+	}
+}
+
+/**
+ * Helper method to rebuild the hash index with a new number of slots.
+ *
+ * @param slotCount	The new number of slots. Must be a power of two.
+ */
+void LogStateTable::Rehash(size_t slotCount)
+{
+	m_slots.assign(slotCount, -1);
+
+	for (size_t i = 0; i < m_entries.size(); ++i)
+	{
+		auto slot = Find(m_entries[i]._record, HashKey(m_entries[i]._record));
+		m_slots[static_cast<size_t>(slot)] = static_cast<int>(i);
+	}
+}
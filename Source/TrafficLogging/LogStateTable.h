@@ -0,0 +1,89 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "LogRecord.h"
+
+
+/**
+ * Class LogStateTable keeps the last record per (node, protocol, object, channel, record) combination.
+ * Entries are held densely in order of first appearance and are looked up through an open addressing
+ * hash index, so updating is constant time and the memory is bounded by the number of distinct objects
+ * instead of the message rate.
+ * The table is not thread safe and is meant to be used from the message thread only.
+ */
+class LogStateTable
+{
+public:
+	enum StateTableConstants
+	{
+		STC_MaxEntries = 65536,	/**< Max. number of distinct objects that are tracked. Further objects are counted as overflow. */
+	};
+
+	struct Entry
+	{
+		LogRecord	_record;			/**< The most recent record received for the object. */
+		uint64		_updateCount{ 0 };	/**< Number of records received for the object. */
+	};
+
+public:
+	LogStateTable();
+	~LogStateTable();
+
+	//==============================================================================
+	void Update(const LogRecord& record);
+	void Clear();
+
+	//==============================================================================
+	int GetSize() const;
+	const Entry& Get(int row) const;
+	uint64 GetOverflowCount() const;
+
+private:
+	static uint64 HashKey(const LogRecord& record);
+	static bool KeyEquals(const LogRecord& a, const LogRecord& b);
+
+	int Find(const LogRecord& record, uint64 hash) const;
+	void Rehash(size_t slotCount);
+
+private:
+	std::vector<Entry>	m_entries;			/**< The table entries, in order of first appearance. */
+	std::vector<int>	m_slots;			/**< Hash index into m_entries, -1 marks an empty slot. Size is a power of two. */
+	uint64				m_overflowCount;	/**< Number of records that were not tracked because the table was full. */
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LogStateTable)
+};
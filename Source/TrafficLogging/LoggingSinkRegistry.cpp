@@ -0,0 +1,305 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#include "LoggingSinkRegistry.h"
+
+
+// **************************************************************************************
+//    class LoggingSinkRegistry::Sink
+// **************************************************************************************
+/**
+ * Constructor for a direct sink, that is delivered to on the engine thread.
+ *
+ * @param target	The target to deliver to.
+ */
+LoggingSinkRegistry::Sink::Sink(LoggingTarget_Interface* target)
+	: Thread("LoggingSink"),
+	m_target(target),
+	m_recordTarget(nullptr)
+{
+}
+
+/**
+ * Constructor for a queued sink. The ring is allocated and the worker thread is started.
+ *
+ * @param recordTarget	The target to deliver the records to.
+ * @param queueCapacity	The number of records the ring can buffer.
+ */
+LoggingSinkRegistry::Sink::Sink(LogRecordTarget_Interface* recordTarget, int queueCapacity)
+	: Thread("LoggingSink"),
+	m_target(nullptr),
+	m_recordTarget(recordTarget)
+{
+	_ring = std::make_unique<LogRecordRing>(queueCapacity);
+	startThread();
+}
+
+/**
+ * Destructor
+ */
+LoggingSinkRegistry::Sink::~Sink()
+{
+	Stop();
+}
+
+/**
+ * Method to hand data to the sink. This is called on engine threads.
+ * Queued sinks copy the data into a record that is pushed to their ring, or dropped if the ring is full.
+ *
+ * @param NId			The node id the logging data comes from
+ * @param SenderPId		The protocol id of the protocol the data was received at
+ * @param SenderType	The protocol type of the protocol that received the data
+ * @param Id			The message id of the data
+ * @param msgData		The actual data that is to be logged
+ */
+void LoggingSinkRegistry::Sink::Deliver(NodeId NId, ProtocolId SenderPId, ProtocolType SenderType, RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData)
+{
+	if (!_filter.Matches(NId, SenderPId, Id, msgData._addrVal._first, msgData._addrVal._second))
+		return;
+
+	if (m_target)
+		m_target->AddLogData(NId, SenderPId, SenderType, Id, msgData);
+	else
+		_ring->Push(LogRecord(NId, SenderPId, SenderType, Id, msgData));
+}
+
+/**
+ * Method to stop the worker thread. Records still queued are discarded.
+ */
+void LoggingSinkRegistry::Sink::Stop()
+{
+	if (isThreadRunning())
+		stopThread(2000);
+}
+
+/**
+ * Reimplemented from Thread. Drains the ring into the record target until the thread is signaled to exit.
+ */
+void LoggingSinkRegistry::Sink::run()
+{
+	LogRecord record;
+	while (!threadShouldExit())
+	{
+		while (!threadShouldExit() && _ring->Pop(record))
+			m_recordTarget->AddLogRecord(record);
+
+		wait(SRC_WorkerPollIntervalMs);
+	}
+}
+
+
+// **************************************************************************************
+//    class LoggingSinkRegistry
+// **************************************************************************************
+/**
+ * Constructor
+ */
+LoggingSinkRegistry::LoggingSinkRegistry()
+	: m_epoch(0)
+{
+	for (auto& activeSink : m_activeSinks)
+		activeSink.store(nullptr, std::memory_order_relaxed);
+	for (auto& activeCallCount : m_activeCallCounts)
+		activeCallCount.store(0, std::memory_order_relaxed);
+}
+
+/**
+ * Destructor
+ */
+LoggingSinkRegistry::~LoggingSinkRegistry()
+{
+	RemoveAllSinks();
+}
+
+/**
+ * Method to register a sink that is delivered to on the engine thread. This must be called on the message thread.
+ * Only for targets that never block or allocate.
+ *
+ * @param target	The target to deliver log data to. It must stay valid until the sink is removed.
+ * @return	The id of the sink, SRC_InvalidSinkId if all sink slots are in use.
+ */
+int LoggingSinkRegistry::AddDirectSink(LoggingTarget_Interface* target)
+{
+	if (!target)
+		return SRC_InvalidSinkId;
+
+	return AddSink(std::make_unique<Sink>(target));
+}
+
+/**
+ * Method to register a sink that gets its own record ring and worker thread. This must be called on the message thread.
+ *
+ * @param target		The target to deliver the records to. It must stay valid until the sink is removed.
+ * @param queueCapacity	The number of records the sink can buffer.
+ * @return	The id of the sink, SRC_InvalidSinkId if all sink slots are in use.
+ */
+int LoggingSinkRegistry::AddQueuedSink(LogRecordTarget_Interface* target, int queueCapacity)
+{
+	if (!target)
+		return SRC_InvalidSinkId;
+
+	return AddSink(std::make_unique<Sink>(target, queueCapacity));
+}
+
+/**
+ * Helper method to put a sink into a free slot.
+ *
+ * @param sink	The sink to register.
+ * @return	The id of the sink, SRC_InvalidSinkId if all sink slots are in use.
+ */
+int LoggingSinkRegistry::AddSink(std::unique_ptr<Sink> sink)
+{
+	for (int i = 0; i < SRC_MaxSinks; ++i)
+	{
+		if (m_sinks[i])
+			continue;
+
+		m_sinks[i] = std::move(sink);
+		m_activeSinks[i].store(m_sinks[i].get(), std::memory_order_release);
+
+		return i;
+	}
+
+	return SRC_InvalidSinkId;
+}
+
+/**
+ * Method to remove a sink. This must be called on the message thread. When this returns,
+ * no engine thread and no worker delivers to the target of the sink anymore.
+ *
+ * @param sinkId	The id of the sink to remove.
+ */
+void LoggingSinkRegistry::RemoveSink(int sinkId)
+{
+	if (sinkId < 0 || sinkId >= SRC_MaxSinks || !m_sinks[sinkId])
+		return;
+
+	// sequentially consistent, pairs with the epoch check and sink load in ::AddLogData. Calls that
+	// started in the previous epoch may still use the sink and are waited for, later calls count
+	// on the other parity and cannot see the sink anymore, so the wait ends even under full load
+	m_activeSinks[sinkId].store(nullptr);
+	auto previousEpoch = m_epoch.fetch_add(1);
+	while (m_activeCallCounts[previousEpoch & 1].load() > 0)
+		Thread::yield();
+
+	m_sinks[sinkId]->Stop();
+	m_sinks[sinkId].reset();
+}
+
+/**
+ * Method to remove all registered sinks.
+ */
+void LoggingSinkRegistry::RemoveAllSinks()
+{
+	for (int i = 0; i < SRC_MaxSinks; ++i)
+		RemoveSink(i);
+}
+
+/**
+ * Getter for the registration state.
+ *
+ * @return	True if at least one sink is registered.
+ */
+bool LoggingSinkRegistry::HasSinks() const
+{
+	for (auto const& sink : m_sinks)
+		if (sink)
+			return true;
+
+	return false;
+}
+
+/**
+ * Getter for the filter of a sink, to configure which data the sink receives.
+ *
+ * @param sinkId	The id of the sink.
+ * @return	The filter, nullptr if no sink is registered with the id.
+ */
+LogRecordFilter* LoggingSinkRegistry::GetSinkFilter(int sinkId)
+{
+	if (sinkId < 0 || sinkId >= SRC_MaxSinks || !m_sinks[sinkId])
+		return nullptr;
+
+	return &m_sinks[sinkId]->_filter;
+}
+
+/**
+ * Getter for the number of records a queued sink dropped because its ring was full.
+ *
+ * @param sinkId	The id of the sink.
+ * @return	The dropped record count, 0 for direct sinks and unknown ids.
+ */
+uint64 LoggingSinkRegistry::GetSinkDroppedCount(int sinkId) const
+{
+	if (sinkId < 0 || sinkId >= SRC_MaxSinks || !m_sinks[sinkId] || !m_sinks[sinkId]->_ring)
+		return 0;
+
+	return m_sinks[sinkId]->_ring->GetDroppedCount();
+}
+
+/**
+ * Reimplemented from LoggingTarget_Interface. This is called on engine threads
+ * and hands the data to all registered sinks.
+ *
+ * @param NId			The node id the logging data comes from
+ * @param SenderPId		The protocol id of the protocol the data was received at
+ * @param SenderType	The protocol type of the protocol that received the data
+ * @param Id			The message id of the data
+ * @param msgData		The actual data that is to be logged
+ */
+void LoggingSinkRegistry::AddLogData(NodeId NId, ProtocolId SenderPId, ProtocolType SenderType, RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData)
+{
+	// count the call for the current epoch. If a sink was removed meanwhile, count again for the
+	// new epoch, so ::RemoveSink never misses a call that can still see the removed sink
+	auto epoch = m_epoch.load();
+	for (;;)
+	{
+		m_activeCallCounts[epoch & 1].fetch_add(1);
+		auto currentEpoch = m_epoch.load();
+		if (currentEpoch == epoch)
+			break;
+
+		m_activeCallCounts[epoch & 1].fetch_sub(1, std::memory_order_release);
+		epoch = currentEpoch;
+	}
+
+	for (auto& activeSink : m_activeSinks)
+	{
+		auto sink = activeSink.load();
+		if (sink)
+			sink->Deliver(NId, SenderPId, SenderType, Id, msgData);
+	}
+
+	m_activeCallCounts[epoch & 1].fetch_sub(1, std::memory_order_release);
+}
@@ -0,0 +1,115 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "LogRecordFilter.h"
+#include "LogRecordRing.h"
+#include "../LoggingTarget_Interface.h"
+#include "../LogRecordTarget_Interface.h"
+
+
+/**
+ * Class LoggingSinkRegistry is the single logging target installed on the engine and fans the log data
+ * out to any number of registered sinks, e.g. the logging window and the statistics exporter.
+ * Every sink has its own filter. Queued sinks additionally get their own bounded record ring and
+ * worker thread, so a slow sink only drops its own records and never stalls the engine thread.
+ * They are handed the records as recorded on the engine thread, with the original timestamp and payload size.
+ * Sinks are registered and removed on the message thread while engine threads deliver concurrently.
+ */
+class LoggingSinkRegistry : public LoggingTarget_Interface
+{
+public:
+	enum SinkRegistryConstants
+	{
+		SRC_MaxSinks				= 8,		/**< Max. number of sinks that can be registered at the same time. */
+		SRC_DefaultQueueCapacity	= 16384,	/**< Default number of records a queued sink can buffer. */
+		SRC_WorkerPollIntervalMs	= 10,		/**< Interval the worker of a queued sink checks its ring with. */
+		SRC_InvalidSinkId			= -1,		/**< Sink id that refers to no sink. */
+	};
+
+public:
+	LoggingSinkRegistry();
+	~LoggingSinkRegistry();
+
+	//==============================================================================
+	int AddDirectSink(LoggingTarget_Interface* target);
+	int AddQueuedSink(LogRecordTarget_Interface* target, int queueCapacity = SRC_DefaultQueueCapacity);
+	void RemoveSink(int sinkId);
+	void RemoveAllSinks();
+	bool HasSinks() const;
+
+	//==============================================================================
+	LogRecordFilter* GetSinkFilter(int sinkId);
+	uint64 GetSinkDroppedCount(int sinkId) const;
+
+	//==============================================================================
+	void AddLogData(NodeId NId, ProtocolId SenderPId, ProtocolType SenderType, RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData) override;
+
+private:
+	/**
+	 * A single registered sink. Direct sinks are delivered to on the engine thread. For queued sinks,
+	 * the worker thread drains the ring into the record target.
+	 */
+	class Sink : private Thread
+	{
+	public:
+		Sink(LoggingTarget_Interface* target);
+		Sink(LogRecordTarget_Interface* recordTarget, int queueCapacity);
+		~Sink();
+
+		void Deliver(NodeId NId, ProtocolId SenderPId, ProtocolType SenderType, RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData);
+		void Stop();
+
+		LogRecordFilter					_filter;	/**< Filter that is checked before data is delivered to the sink. */
+		std::unique_ptr<LogRecordRing>	_ring;		/**< Queue between engine threads and the worker, only for queued delivery. */
+
+	private:
+		void run() override;
+
+		LoggingTarget_Interface*		m_target;		/**< The target data is delivered to on the engine thread, nullptr for queued sinks. */
+		LogRecordTarget_Interface*		m_recordTarget;	/**< The target records are delivered to on the worker thread, nullptr for direct sinks. */
+	};
+
+	int AddSink(std::unique_ptr<Sink> sink);
+
+	std::unique_ptr<Sink>				m_sinks[SRC_MaxSinks];			/**< The registered sinks, owned and modified on the message thread. */
+	std::atomic<Sink*>					m_activeSinks[SRC_MaxSinks];	/**< The registered sinks as seen by the engine threads. */
+	std::atomic<uint32>					m_epoch;						/**< Increased with every sink removal, calls are counted per epoch parity. */
+	std::atomic<int>					m_activeCallCounts[2];			/**< Number of engine threads currently delivering per epoch parity, to know when a removed sink is unused. */
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LoggingSinkRegistry)
+};
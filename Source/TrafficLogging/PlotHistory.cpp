@@ -0,0 +1,221 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#include "PlotHistory.h"
+
+
+// **************************************************************************************
+//    class PlotHistory
+// **************************************************************************************
+/**
+ * Constructor. The time series of all tiers are allocated and zero filled here.
+ */
+PlotHistory::PlotHistory()
+{
+	for (int i = 0; i < HT_MAX; ++i)
+	{
+		auto capacity = GetCapacity(static_cast<HistoryTier>(i));
+		m_tiers[i]._min = std::make_unique<PlotTimeSeries>(capacity);
+		m_tiers[i]._avg = std::make_unique<PlotTimeSeries>(capacity);
+		m_tiers[i]._max = std::make_unique<PlotTimeSeries>(capacity);
+	}
+}
+
+/**
+ * Destructor
+ */
+PlotHistory::~PlotHistory()
+{
+}
+
+/**
+ * Method to append a sample. This is expected to be called every HC_FineStepMs.
+ *
+ * @param value	The sample value.
+ */
+void PlotHistory::Push(float value)
+{
+	PushBucket(HT_Fine, value, value, value);
+}
+
+/**
+ * Getter for the min values of a tier.
+ *
+ * @param tier	The tier to get the values of.
+ * @return	The time series of min values per bucket.
+ */
+const PlotTimeSeries& PlotHistory::GetMin(HistoryTier tier) const
+{
+	return *m_tiers[tier]._min;
+}
+
+/**
+ * Getter for the average values of a tier.
+ *
+ * @param tier	The tier to get the values of.
+ * @return	The time series of average values per bucket.
+ */
+const PlotTimeSeries& PlotHistory::GetAvg(HistoryTier tier) const
+{
+	return *m_tiers[tier]._avg;
+}
+
+/**
+ * Getter for the max values of a tier.
+ *
+ * @param tier	The tier to get the values of.
+ * @return	The time series of max values per bucket.
+ */
+const PlotTimeSeries& PlotHistory::GetMax(HistoryTier tier) const
+{
+	return *m_tiers[tier]._max;
+}
+
+/**
+ * Getter for the largest value within the newest buckets of a tier.
+ * If the complete tier is requested, the running max of the series is used, otherwise the buckets are scanned.
+ *
+ * @param tier			The tier to get the max of.
+ * @param bucketCount	The number of newest buckets to get the max of.
+ * @return	The max value.
+ */
+float PlotHistory::GetMaxOfNewest(HistoryTier tier, int bucketCount) const
+{
+	auto const& maxSeries = GetMax(tier);
+	if (bucketCount >= maxSeries.GetSize())
+		return maxSeries.GetMax();
+
+	auto max = 0.0f;
+	for (int i = maxSeries.GetSize() - jmax(0, bucketCount); i < maxSeries.GetSize(); ++i)
+		max = jmax(max, maxSeries.Get(i));
+
+	return max;
+}
+
+/**
+ * Helper method to get the finest tier that covers a time range.
+ *
+ * @param rangeMs	The time range in ms.
+ * @return	The tier to use for the range. If no tier covers the range, the coarsest is returned.
+ */
+PlotHistory::HistoryTier PlotHistory::GetTierForRange(int rangeMs)
+{
+	for (int i = 0; i < HT_MAX; ++i)
+	{
+		auto tier = static_cast<HistoryTier>(i);
+		if (int64(GetStepMs(tier)) * GetCapacity(tier) >= rangeMs)
+			return tier;
+	}
+
+	return HT_Coarse;
+}
+
+/**
+ * Helper method to get the bucket width of a tier.
+ *
+ * @param tier	The tier to get the bucket width of.
+ * @return	The bucket width in ms.
+ */
+int PlotHistory::GetStepMs(HistoryTier tier)
+{
+	switch (tier)
+	{
+	case HT_Medium:
+		return HC_MediumStepMs;
+	case HT_Coarse:
+		return HC_CoarseStepMs;
+	case HT_Fine:
+	default:
+		return HC_FineStepMs;
+	}
+}
+
+/**
+ * Helper method to get the number of buckets kept in a tier.
+ *
+ * @param tier	The tier to get the capacity of.
+ * @return	The number of buckets.
+ */
+int PlotHistory::GetCapacity(HistoryTier tier)
+{
+	switch (tier)
+	{
+	case HT_Medium:
+		return HC_MediumCapacity;
+	case HT_Coarse:
+		return HC_CoarseCapacity;
+	case HT_Fine:
+	default:
+		return HC_FineCapacity;
+	}
+}
+
+/**
+ * Helper method to append a completed bucket to a tier and collect it for the next coarser tier.
+ *
+ * @param tierIndex	The tier to append the bucket to.
+ * @param min		The min value of the bucket.
+ * @param avg		The average value of the bucket.
+ * @param max		The max value of the bucket.
+ */
+void PlotHistory::PushBucket(int tierIndex, float min, float avg, float max)
+{
+	auto& tier = m_tiers[tierIndex];
+	tier._min->Push(min);
+	tier._avg->Push(avg);
+	tier._max->Push(max);
+
+	auto coarserTierIndex = tierIndex + 1;
+	if (coarserTierIndex >= HT_MAX)
+		return;
+
+	auto& coarserTier = m_tiers[coarserTierIndex];
+	coarserTier._pendingMin = (coarserTier._pendingCount == 0) ? min : jmin(coarserTier._pendingMin, min);
+	coarserTier._pendingMax = (coarserTier._pendingCount == 0) ? max : jmax(coarserTier._pendingMax, max);
+	coarserTier._pendingSum += avg;
+	coarserTier._pendingCount++;
+
+	auto bucketsPerCoarserBucket = GetStepMs(static_cast<HistoryTier>(coarserTierIndex)) / GetStepMs(static_cast<HistoryTier>(tierIndex));
+	if (coarserTier._pendingCount >= bucketsPerCoarserBucket)
+	{
+		auto coarserAvg = static_cast<float>(coarserTier._pendingSum / coarserTier._pendingCount);
+		auto coarserMin = coarserTier._pendingMin;
+		auto coarserMax = coarserTier._pendingMax;
+
+		coarserTier._pendingSum = 0.0;
+		coarserTier._pendingCount = 0;
+
+		PushBucket(coarserTierIndex, coarserMin, coarserAvg, coarserMax);
+	}
+}
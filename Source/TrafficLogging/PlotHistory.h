@@ -0,0 +1,106 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "PlotTimeSeries.h"
+
+
+/**
+ * Class PlotHistory keeps the history of a plotted value in tiers of decreasing resolution.
+ * Every tier holds min/avg/max buckets in fixed capacity time series. The tiers are updated
+ * incrementally, a coarser bucket is completed from the finer buckets as soon as they are full,
+ * so no raw samples have to be kept to show long time ranges.
+ */
+class PlotHistory
+{
+public:
+	enum HistoryTier
+	{
+		HT_Fine = 0,	/**< Buckets of the base sample interval. */
+		HT_Medium,		/**< Buckets of 5 seconds. */
+		HT_Coarse,		/**< Buckets of 1 minute. */
+		HT_MAX
+	};
+
+	enum HistoryConstants
+	{
+		HC_FineStepMs		= 200,		/**< Interval in ms new samples are pushed with. */
+		HC_MediumStepMs		= 5000,		/**< Bucket width of the medium tier in ms. */
+		HC_CoarseStepMs		= 60000,	/**< Bucket width of the coarse tier in ms. */
+		HC_FineCapacity		= 1500,		/**< Number of fine buckets kept (5 min). */
+		HC_MediumCapacity	= 720,		/**< Number of medium buckets kept (1 h). */
+		HC_CoarseCapacity	= 720,		/**< Number of coarse buckets kept (12 h). */
+	};
+
+public:
+	PlotHistory();
+	~PlotHistory();
+
+	//==============================================================================
+	void Push(float value);
+
+	//==============================================================================
+	const PlotTimeSeries& GetMin(HistoryTier tier) const;
+	const PlotTimeSeries& GetAvg(HistoryTier tier) const;
+	const PlotTimeSeries& GetMax(HistoryTier tier) const;
+	float GetMaxOfNewest(HistoryTier tier, int bucketCount) const;
+
+	//==============================================================================
+	static HistoryTier GetTierForRange(int rangeMs);
+	static int GetStepMs(HistoryTier tier);
+	static int GetCapacity(HistoryTier tier);
+
+private:
+	struct Tier
+	{
+		std::unique_ptr<PlotTimeSeries>	_min;			/**< Min value per bucket. */
+		std::unique_ptr<PlotTimeSeries>	_avg;			/**< Average value per bucket. */
+		std::unique_ptr<PlotTimeSeries>	_max;			/**< Max value per bucket. */
+
+		float	_pendingMin{ 0.0f };	/**< Min of the finer buckets collected for the current bucket. */
+		float	_pendingMax{ 0.0f };	/**< Max of the finer buckets collected for the current bucket. */
+		double	_pendingSum{ 0.0 };		/**< Sum of the averages of the finer buckets collected for the current bucket. */
+		int		_pendingCount{ 0 };		/**< Number of finer buckets collected for the current bucket. */
+	};
+
+	void PushBucket(int tierIndex, float min, float avg, float max);
+
+private:
+	Tier	m_tiers[HT_MAX];	/**< The history tiers, from fine to coarse. */
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PlotHistory)
+};
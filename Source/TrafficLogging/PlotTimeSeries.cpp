@@ -0,0 +1,135 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#include "PlotTimeSeries.h"
+
+
+// **************************************************************************************
+//    class PlotTimeSeries
+// **************************************************************************************
+/**
+ * Constructor. The series is initially filled with zero values.
+ *
+ * @param capacity	The number of values in the series.
+ */
+PlotTimeSeries::PlotTimeSeries(int capacity)
+	: m_capacity(jmax(1, capacity))
+{
+	auto bufferSize = static_cast<size_t>(nextPowerOfTwo(m_capacity));
+	m_values.resize(bufferSize);
+	m_mask = bufferSize - 1;
+
+	// one candidate more than values, since the outdated front is dropped after pushing
+	auto candidateBufferSize = static_cast<size_t>(nextPowerOfTwo(m_capacity + 1));
+	m_maxCandidates.resize(candidateBufferSize);
+	m_maxMask = candidateBufferSize - 1;
+
+	Clear();
+}
+
+/**
+ * Destructor
+ */
+PlotTimeSeries::~PlotTimeSeries()
+{
+}
+
+/**
+ * Method to append a value and drop the oldest one.
+ *
+ * @param value	The value to append.
+ */
+void PlotTimeSeries::Push(float value)
+{
+	m_values[(m_head + static_cast<size_t>(m_capacity)) & m_mask] = value;
+	m_head = (m_head + 1) & m_mask;
+	m_pushCount++;
+
+	// drop candidates that can never become the max again, since the new value is larger and lives longer
+	while (m_maxCount > 0 && m_maxCandidates[(m_maxFront + m_maxCount - 1) & m_maxMask]._value <= value)
+		m_maxCount--;
+	m_maxCandidates[(m_maxFront + m_maxCount) & m_maxMask] = { m_pushCount, value };
+	m_maxCount++;
+
+	// drop the front candidate if it left the window
+	if (m_maxCandidates[m_maxFront]._pushIndex + static_cast<uint64>(m_capacity) <= m_pushCount)
+	{
+		m_maxFront = (m_maxFront + 1) & m_maxMask;
+		m_maxCount--;
+	}
+}
+
+/**
+ * Method to reset all values of the series to zero.
+ */
+void PlotTimeSeries::Clear()
+{
+	std::fill(m_values.begin(), m_values.end(), 0.0f);
+	m_head = 0;
+	m_pushCount = 0;
+
+	m_maxCandidates[0] = { 0, 0.0f };
+	m_maxFront = 0;
+	m_maxCount = 1;
+}
+
+/**
+ * Getter for the number of values in the series.
+ *
+ * @return	The series capacity.
+ */
+int PlotTimeSeries::GetSize() const
+{
+	return m_capacity;
+}
+
+/**
+ * Getter for the most recently pushed value.
+ *
+ * @return	The newest value.
+ */
+float PlotTimeSeries::GetNewest() const
+{
+	return Get(m_capacity - 1);
+}
+
+/**
+ * Getter for the largest value currently in the series.
+ *
+ * @return	The maximum.
+ */
+float PlotTimeSeries::GetMax() const
+{
+	return m_maxCandidates[m_maxFront]._value;
+}
@@ -0,0 +1,92 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+
+/**
+ * Class PlotTimeSeries is a fixed capacity time series of float values. New values are pushed at
+ * the end and push out the oldest value once the capacity is reached. Storage is a single contiguous
+ * ring buffer that is allocated on construction, and the maximum over the complete window is kept
+ * up to date with a monotonic queue, so pushing and querying the maximum are amortized O(1).
+ */
+class PlotTimeSeries
+{
+public:
+	PlotTimeSeries(int capacity);
+	~PlotTimeSeries();
+
+	//==============================================================================
+	void Push(float value);
+	void Clear();
+
+	//==============================================================================
+	int GetSize() const;
+
+	/**
+	 * Getter for a value of the series.
+	 *
+	 * @param index	The position in the series, 0 being the oldest and GetSize()-1 the newest value.
+	 * @return	The value.
+	 */
+	float Get(int index) const
+	{
+		return m_values[(m_head + static_cast<size_t>(index)) & m_mask];
+	};
+
+	float GetNewest() const;
+	float GetMax() const;
+
+private:
+	struct MaxCandidate
+	{
+		uint64	_pushIndex;	/**< Overall push count at the time the value was pushed. */
+		float	_value;		/**< The candidate value. */
+	};
+
+	std::vector<float>			m_values;			/**< Ring buffer of the series values. Size is a power of two >= capacity. */
+	size_t						m_mask;				/**< Mask to wrap indices into m_values. */
+	size_t						m_head;				/**< Position of the oldest value in m_values. */
+	int							m_capacity;			/**< Number of values in the series. */
+	uint64						m_pushCount;		/**< Overall number of pushed values. */
+
+	std::vector<MaxCandidate>	m_maxCandidates;	/**< Ring buffer of decreasing max candidates within the window. */
+	size_t						m_maxMask;			/**< Mask to wrap indices into m_maxCandidates. */
+	size_t						m_maxFront;			/**< Position of the current max in m_maxCandidates. */
+	size_t						m_maxCount;			/**< Number of candidates in m_maxCandidates. */
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PlotTimeSeries)
+};
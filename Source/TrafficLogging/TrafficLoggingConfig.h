@@ -0,0 +1,81 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+
+/**
+ * Names of the TRAFFICLOGGING configuration element attributes that are only
+ * evaluated by the ui and therefor are not part of ProcessingEngineConfig::AttributeID.
+ * Missing attributes are read with the defaults defined in TrafficLoggingDefaults.
+ */
+namespace TrafficLoggingAttributes
+{
+	constexpr const char* MaxRecords	= "MaxRecords";		/**< Max. number of records the traffic log retains. */
+	constexpr const char* MaxMemoryMB	= "MaxMemoryMB";	/**< Max. memory in MB the traffic log retains records and their search index postings in. */
+	constexpr const char* MaxAgeSeconds	= "MaxAgeSeconds";	/**< Max. age in seconds of records the traffic log retains. 0 for no limit. */
+
+	constexpr const char* IngestBudgetPercent	= "IngestBudgetPercent";	/**< Share of the ui flush period in percent the automatic sampling keeps the log ingest within. */
+
+	constexpr const char* StatsExportFormat				= "StatsExportFormat";			/**< Format of the headless statistics export, one of TrafficStatsExportFormat. */
+	constexpr const char* StatsExportIntervalSeconds	= "StatsExportIntervalSeconds";	/**< Interval in seconds statistics snapshots are written with. */
+	constexpr const char* StatsExportFile				= "StatsExportFile";			/**< Full path of the statistics file. Empty for the default location. */
+}
+
+/**
+ * Formats the headless traffic statistics can be exported in.
+ */
+enum TrafficStatsExportFormat
+{
+	TSEF_Off = 0,		/**< No statistics are collected or exported. */
+	TSEF_Prometheus,	/**< Prometheus text exposition format, the file is replaced with every snapshot. */
+	TSEF_JsonLines,		/**< One JSON object per snapshot, appended to the file. */
+};
+
+/**
+ * Default values for the TRAFFICLOGGING attributes defined in TrafficLoggingAttributes.
+ */
+enum TrafficLoggingDefaults
+{
+	TLD_MaxRecords		= 500000,
+	TLD_MaxMemoryMB		= 32,
+	TLD_MaxAgeSeconds	= 3600,
+
+	TLD_IngestBudgetPercent	= 20,
+
+	TLD_StatsExportFormat			= TSEF_Off,
+	TLD_StatsExportIntervalSeconds	= 10,
+};
@@ -0,0 +1,349 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#include "TrafficStatistics.h"
+
+#include "ProcessingEngine/ProcessingEngineConfig.h"
+
+
+// **************************************************************************************
+//    class TrafficStatisticsCollector
+// **************************************************************************************
+/**
+ * Constructor
+ */
+TrafficStatisticsCollector::TrafficStatisticsCollector()
+	: Thread("TrafficStatisticsCollector")
+{
+	m_rxMessageCounters = std::make_unique<AtomicCounterArray>(SC_ProtocolCountRange);
+	m_rxByteCounters = std::make_unique<AtomicCounterArray>(SC_ProtocolCountRange);
+
+	m_protocolNodes = std::make_unique<std::atomic<int>[]>(SC_ProtocolCountRange);
+	m_protocolTypes = std::make_unique<std::atomic<int>[]>(SC_ProtocolCountRange);
+	for (int i = 0; i < SC_ProtocolCountRange; ++i)
+	{
+		m_protocolNodes[i].store(0, std::memory_order_relaxed);
+		m_protocolTypes[i].store(PT_Invalid, std::memory_order_relaxed);
+	}
+
+	m_format = TSEF_Off;
+	m_intervalMs = TLD_StatsExportIntervalSeconds * 1000;
+	m_lastSnapshotTime = 0.0;
+
+	m_protocolTotals.resize(SC_ProtocolCountRange);
+	m_unattributedMessages = 0;
+}
+
+/**
+ * Destructor
+ */
+TrafficStatisticsCollector::~TrafficStatisticsCollector()
+{
+	Stop();
+}
+
+/**
+ * Method to start writing periodic statistics snapshots. An export that is already running is stopped first.
+ * The cumulated counters are kept, so restarting with a new configuration does not reset them.
+ *
+ * @param exportFile	The file to write the snapshots to.
+ * @param format		The format to write the snapshots in.
+ * @param intervalMs	The interval to write snapshots with.
+ * @return	True if the export was started.
+ */
+bool TrafficStatisticsCollector::Start(const File& exportFile, TrafficStatsExportFormat format, int intervalMs)
+{
+	Stop();
+
+	if (format == TSEF_Off)
+		return false;
+
+	auto exportDirectory = exportFile.getParentDirectory();
+	if (!exportDirectory.isDirectory() && !exportDirectory.createDirectory().wasOk())
+		return false;
+
+	m_exportFile = exportFile;
+	m_format = format;
+	m_intervalMs = jmax(static_cast<int>(SC_MinIntervalMs), intervalMs);
+	m_lastSnapshotTime = Time::getMillisecondCounterHiRes();
+
+	startThread();
+
+	return true;
+}
+
+/**
+ * Method to stop writing statistics snapshots. A final snapshot is written before the thread exits.
+ */
+void TrafficStatisticsCollector::Stop()
+{
+	if (isThreadRunning())
+	{
+		signalThreadShouldExit();
+		notify();
+		stopThread(2000);
+	}
+
+	m_format = TSEF_Off;
+}
+
+/**
+ * Getter for the export state.
+ *
+ * @return	True if statistics snapshots are currently written.
+ */
+bool TrafficStatisticsCollector::IsExporting() const
+{
+	return isThreadRunning();
+}
+
+/**
+ * Helper method to check if the running export matches the given configuration,
+ * to avoid restarting it on configuration updates that do not affect it.
+ *
+ * @param exportFile	The file snapshots are to be written to.
+ * @param format		The format snapshots are to be written in.
+ * @param intervalMs	The interval snapshots are to be written with.
+ * @return	True if statistics are currently exported with the given configuration.
+ */
+bool TrafficStatisticsCollector::IsExportingWith(const File& exportFile, TrafficStatsExportFormat format, int intervalMs) const
+{
+	return IsExporting()
+		&& m_exportFile == exportFile
+		&& m_format == format
+		&& m_intervalMs == jmax(static_cast<int>(SC_MinIntervalMs), intervalMs);
+}
+
+/**
+ * Method to record that a configuration change was applied to the bridge. This is called on the message thread.
+ *
+ * @param engineRestarted	True if the engine had to be restarted to apply the change.
+ * @param downtimeMs		Time in ms from stopping the engine until it was running with the new configuration, 0 if not restarted.
+ */
+void TrafficStatisticsCollector::RecordReconfiguration(bool engineRestarted, double downtimeMs)
+{
+	m_reconfigurationCount.fetch_add(1, std::memory_order_relaxed);
+	if (!engineRestarted)
+		return;
+
+	m_reconfigurationRestartCount.fetch_add(1, std::memory_order_relaxed);
+	m_lastReconfigurationDowntimeMs.store(downtimeMs, std::memory_order_relaxed);
+	m_reconfigurationDowntimeMs.store(m_reconfigurationDowntimeMs.load(std::memory_order_relaxed) + downtimeMs, std::memory_order_relaxed);
+}
+
+/**
+ * Reimplemented from LoggingTarget_Interface. This is called on engine threads,
+ * therefor only lock-free counters are increased.
+ *
+ * @param NId			The node id the logging data comes from
+ * @param SenderPId		The protocol id of the protocol the data was received at
+ * @param SenderType	The protocol type of the protocol that received the data
+ * @param Id			The message id of the data
+ * @param msgData		The actual data that is to be logged
+ */
+void TrafficStatisticsCollector::AddLogData(NodeId NId, ProtocolId SenderPId, ProtocolType SenderType, RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData)
+{
+	auto protocolIndex = static_cast<int>(SenderPId);
+	m_rxMessageCounters->Increase(protocolIndex);
+	m_rxByteCounters->Increase(protocolIndex, msgData._payloadSize);
+
+	if (protocolIndex >= 0 && protocolIndex < SC_ProtocolCountRange)
+	{
+		// only store on change, to keep the cache lines shared between the engine threads
+		if (m_protocolNodes[protocolIndex].load(std::memory_order_relaxed) != static_cast<int>(NId))
+			m_protocolNodes[protocolIndex].store(static_cast<int>(NId), std::memory_order_relaxed);
+		if (m_protocolTypes[protocolIndex].load(std::memory_order_relaxed) != static_cast<int>(SenderType))
+			m_protocolTypes[protocolIndex].store(static_cast<int>(SenderType), std::memory_order_relaxed);
+	}
+}
+
+/**
+ * Helper method to get the default location of the statistics file.
+ *
+ * @param format	The export format, to choose the file extension.
+ * @return	The default statistics file.
+ */
+File TrafficStatisticsCollector::GetDefaultExportFile(TrafficStatsExportFormat format)
+{
+	auto statisticsDirectory = File::getSpecialLocation(File::userDocumentsDirectory).getChildFile("RemoteProtocolBridge").getChildFile("Statistics");
+
+	return statisticsDirectory.getChildFile(format == TSEF_JsonLines ? "BridgeStatistics.jsonl" : "BridgeStatistics.prom");
+}
+
+/**
+ * Reimplemented from Thread. Takes a snapshot every interval until the thread is signaled to exit.
+ */
+void TrafficStatisticsCollector::run()
+{
+	while (!threadShouldExit())
+	{
+		wait(m_intervalMs);
+
+		if (!threadShouldExit())
+			TakeSnapshot();
+	}
+
+	TakeSnapshot();
+}
+
+/**
+ * Helper method to take the counts of the last interval into the cumulated statistics
+ * and write them to the export file.
+ */
+void TrafficStatisticsCollector::TakeSnapshot()
+{
+	for (int i = 0; i < SC_ProtocolCountRange; ++i)
+	{
+		auto& totals = m_protocolTotals[static_cast<size_t>(i)];
+		totals._intervalMessages = m_rxMessageCounters->TakeCount(i);
+		totals._intervalBytes = m_rxByteCounters->TakeCount(i);
+		totals._rxMessages += totals._intervalMessages;
+		totals._rxBytes += totals._intervalBytes;
+	}
+	m_unattributedMessages += m_rxMessageCounters->TakeOverflowCount();
+	m_rxByteCounters->TakeOverflowCount();
+
+	if (m_format == TSEF_Prometheus)
+		WritePrometheusSnapshot();
+	else if (m_format == TSEF_JsonLines)
+		WriteJsonLinesSnapshot();
+
+	m_lastSnapshotTime = Time::getMillisecondCounterHiRes();
+}
+
+/**
+ * Helper method to write the current statistics in Prometheus text exposition format.
+ * The file is written to a temporary file first and then moved over the export file,
+ * so a scraper never reads a partially written snapshot.
+ */
+void TrafficStatisticsCollector::WritePrometheusSnapshot()
+{
+	String text;
+
+	text << "# HELP rpb_rx_messages_total Messages received per bridging node and protocol.\n"
+		<< "# TYPE rpb_rx_messages_total counter\n";
+	for (int i = 0; i < SC_ProtocolCountRange; ++i)
+		if (m_protocolTypes[i].load(std::memory_order_relaxed) != PT_Invalid)
+			text << "rpb_rx_messages_total{" << GetProtocolLabels(i) << "} " << String(m_protocolTotals[static_cast<size_t>(i)]._rxMessages) << "\n";
+
+	text << "# HELP rpb_rx_bytes_total Payload bytes received per bridging node and protocol.\n"
+		<< "# TYPE rpb_rx_bytes_total counter\n";
+	for (int i = 0; i < SC_ProtocolCountRange; ++i)
+		if (m_protocolTypes[i].load(std::memory_order_relaxed) != PT_Invalid)
+			text << "rpb_rx_bytes_total{" << GetProtocolLabels(i) << "} " << String(m_protocolTotals[static_cast<size_t>(i)]._rxBytes) << "\n";
+
+	text << "# HELP rpb_rx_unattributed_messages_total Messages received on protocol ids that are not counted individually.\n"
+		<< "# TYPE rpb_rx_unattributed_messages_total counter\n"
+		<< "rpb_rx_unattributed_messages_total " << String(m_unattributedMessages) << "\n";
+
+	text << "# HELP rpb_reconfigurations_total Configuration changes applied to the bridge.\n"
+		<< "# TYPE rpb_reconfigurations_total counter\n"
+		<< "rpb_reconfigurations_total " << String(m_reconfigurationCount.load(std::memory_order_relaxed)) << "\n";
+
+	text << "# HELP rpb_reconfiguration_restarts_total Configuration changes that required restarting the engine.\n"
+		<< "# TYPE rpb_reconfiguration_restarts_total counter\n"
+		<< "rpb_reconfiguration_restarts_total " << String(m_reconfigurationRestartCount.load(std::memory_order_relaxed)) << "\n";
+
+	text << "# HELP rpb_reconfiguration_downtime_milliseconds_total Bridging downtime caused by configuration changes.\n"
+		<< "# TYPE rpb_reconfiguration_downtime_milliseconds_total counter\n"
+		<< "rpb_reconfiguration_downtime_milliseconds_total " << String(m_reconfigurationDowntimeMs.load(std::memory_order_relaxed), 3) << "\n";
+
+	text << "# HELP rpb_reconfiguration_last_downtime_milliseconds Bridging downtime of the last engine restart for a configuration change.\n"
+		<< "# TYPE rpb_reconfiguration_last_downtime_milliseconds gauge\n"
+		<< "rpb_reconfiguration_last_downtime_milliseconds " << String(m_lastReconfigurationDowntimeMs.load(std::memory_order_relaxed), 3) << "\n";
+
+	text << "# HELP rpb_statistics_timestamp_seconds Wall clock time of this snapshot.\n"
+		<< "# TYPE rpb_statistics_timestamp_seconds gauge\n"
+		<< "rpb_statistics_timestamp_seconds " << String(Time::currentTimeMillis() / 1000) << "\n";
+
+	TemporaryFile tempFile(m_exportFile);
+	if (tempFile.getFile().replaceWithText(text))
+		tempFile.overwriteTargetFileWithTemporary();
+}
+
+/**
+ * Helper method to append the current statistics as a single JSON object line to the export file.
+ * Besides the cumulated counters, the counts and rates of the last interval are contained.
+ */
+void TrafficStatisticsCollector::WriteJsonLinesSnapshot()
+{
+	auto intervalSeconds = jmax(0.001, (Time::getMillisecondCounterHiRes() - m_lastSnapshotTime) / 1000.0);
+
+	Array<var> protocols;
+	for (int i = 0; i < SC_ProtocolCountRange; ++i)
+	{
+		auto protocolType = m_protocolTypes[i].load(std::memory_order_relaxed);
+		if (protocolType == PT_Invalid)
+			continue;
+
+		auto const& totals = m_protocolTotals[static_cast<size_t>(i)];
+
+		auto protocol = new DynamicObject();
+		protocol->setProperty("node", m_protocolNodes[i].load(std::memory_order_relaxed));
+		protocol->setProperty("protocol", i);
+		protocol->setProperty("type", ProcessingEngineConfig::ProtocolTypeToString(static_cast<ProtocolType>(protocolType)));
+		protocol->setProperty("rxMessages", static_cast<int64>(totals._rxMessages));
+		protocol->setProperty("rxBytes", static_cast<int64>(totals._rxBytes));
+		protocol->setProperty("rxMessagesPerSecond", double(totals._intervalMessages) / intervalSeconds);
+		protocol->setProperty("rxBytesPerSecond", double(totals._intervalBytes) / intervalSeconds);
+		protocols.add(var(protocol));
+	}
+
+	auto snapshot = new DynamicObject();
+	snapshot->setProperty("timestamp", Time::getCurrentTime().toISO8601(true));
+	snapshot->setProperty("intervalSeconds", intervalSeconds);
+	snapshot->setProperty("protocols", protocols);
+	snapshot->setProperty("rxUnattributedMessages", static_cast<int64>(m_unattributedMessages));
+	snapshot->setProperty("reconfigurations", static_cast<int64>(m_reconfigurationCount.load(std::memory_order_relaxed)));
+	snapshot->setProperty("reconfigurationRestarts", static_cast<int64>(m_reconfigurationRestartCount.load(std::memory_order_relaxed)));
+	snapshot->setProperty("reconfigurationDowntimeMs", m_reconfigurationDowntimeMs.load(std::memory_order_relaxed));
+	snapshot->setProperty("lastReconfigurationDowntimeMs", m_lastReconfigurationDowntimeMs.load(std::memory_order_relaxed));
+
+	m_exportFile.appendText(JSON::toString(var(snapshot), true) + "\n");
+}
+
+/**
+ * Helper method to get the Prometheus labels of a protocol.
+ *
+ * @param protocolIndex	The protocol id.
+ * @return	The labels, without surrounding braces.
+ */
+String TrafficStatisticsCollector::GetProtocolLabels(int protocolIndex) const
+{
+	auto protocolType = static_cast<ProtocolType>(m_protocolTypes[protocolIndex].load(std::memory_order_relaxed));
+
+	return "node=\"" + String(m_protocolNodes[protocolIndex].load(std::memory_order_relaxed))
+		+ "\",protocol=\"" + String(protocolIndex)
+		+ "\",type=\"" + ProcessingEngineConfig::ProtocolTypeToString(protocolType) + "\"";
+}
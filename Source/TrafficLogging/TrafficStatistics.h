@@ -0,0 +1,121 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "AtomicCounterArray.h"
+#include "TrafficLoggingConfig.h"
+#include "../LoggingTarget_Interface.h"
+
+
+/**
+ * Class TrafficStatisticsCollector gathers bridge health statistics independent of the traffic logging window
+ * and periodically writes them as snapshots to a local file that monitoring can scrape.
+ * It is registered as direct sink of the LoggingSinkRegistry while exporting, so it sees all traffic independent
+ * of slower sinks. Per message only a few relaxed atomic counters are increased, all aggregation and file io
+ * happens on a background thread.
+ * The counts rely on the engine logging path, which is the only per message hook the engine offers to the ui,
+ * so exporting enables engine logging.
+ */
+class TrafficStatisticsCollector :	public LoggingTarget_Interface,
+									private Thread
+{
+public:
+	enum StatisticsConstants
+	{
+		SC_ProtocolCountRange	= 256,	/**< Protocol ids that are counted individually, others are counted as unattributed. */
+		SC_MinIntervalMs		= 1000,	/**< Lower limit of the snapshot interval. */
+	};
+
+public:
+	TrafficStatisticsCollector();
+	~TrafficStatisticsCollector();
+
+	//==============================================================================
+	bool Start(const File& exportFile, TrafficStatsExportFormat format, int intervalMs);
+	void Stop();
+	bool IsExporting() const;
+	bool IsExportingWith(const File& exportFile, TrafficStatsExportFormat format, int intervalMs) const;
+
+	//==============================================================================
+	void RecordReconfiguration(bool engineRestarted, double downtimeMs);
+
+	//==============================================================================
+	void AddLogData(NodeId NId, ProtocolId SenderPId, ProtocolType SenderType, RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData) override;
+
+	//==============================================================================
+	static File GetDefaultExportFile(TrafficStatsExportFormat format);
+
+private:
+	/**
+	 * Cumulated statistics of a single protocol, only accessed by the snapshot thread.
+	 */
+	struct ProtocolTotals
+	{
+		uint64	_rxMessages{ 0 };		/**< Overall count of messages received on the protocol. */
+		uint64	_rxBytes{ 0 };			/**< Overall count of payload bytes received on the protocol. */
+		uint32	_intervalMessages{ 0 };	/**< Count of messages received during the last snapshot interval. */
+		uint32	_intervalBytes{ 0 };	/**< Count of payload bytes received during the last snapshot interval. */
+	};
+
+	void run() override;
+
+	void TakeSnapshot();
+	void WritePrometheusSnapshot();
+	void WriteJsonLinesSnapshot();
+	String GetProtocolLabels(int protocolIndex) const;
+
+private:
+	std::unique_ptr<AtomicCounterArray>					m_rxMessageCounters;	/**< Messages received per protocol since the last snapshot. */
+	std::unique_ptr<AtomicCounterArray>					m_rxByteCounters;		/**< Payload bytes received per protocol since the last snapshot. */
+	std::unique_ptr<std::atomic<int>[]>					m_protocolNodes;		/**< Node id each protocol was last seen in. */
+	std::unique_ptr<std::atomic<int>[]>					m_protocolTypes;		/**< Protocol type each protocol was last seen with, PT_Invalid if never seen. */
+
+	File												m_exportFile;			/**< The file snapshots are written to. */
+	TrafficStatsExportFormat							m_format;				/**< The format snapshots are written in. */
+	int													m_intervalMs;			/**< The interval snapshots are written with. */
+	double												m_lastSnapshotTime;		/**< Time of the last snapshot, as delivered by Time::getMillisecondCounterHiRes. */
+
+	std::vector<ProtocolTotals>							m_protocolTotals;		/**< Cumulated statistics per protocol. */
+	uint64												m_unattributedMessages;	/**< Overall count of messages of protocol ids out of the counted range. */
+
+	std::atomic<uint64>									m_reconfigurationCount{ 0 };	/**< Count of configuration changes that were applied. */
+	std::atomic<uint64>									m_reconfigurationRestartCount{ 0 };	/**< Count of configuration changes that required restarting the engine. */
+	std::atomic<double>									m_lastReconfigurationDowntimeMs{ 0.0 };	/**< Bridging downtime of the last engine restart for a configuration change. */
+	std::atomic<double>									m_reconfigurationDowntimeMs{ 0.0 };	/**< Overall bridging downtime caused by configuration changes. */
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TrafficStatisticsCollector)
+};